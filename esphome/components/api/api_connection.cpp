@@ -26,6 +26,12 @@ namespace api {
 
 static const char *const TAG = "api.connection";
 static const int ESP32_CAMERA_STOP_STREAM = 5000;
+#ifdef USE_ESP32_CAMERA
+/// Size of the image data in each CameraImageResponse
+static const size_t ESP32_CAMERA_CHUNK_SIZE = 2048;
+/// Maximum number of image bytes handed to the socket in one loop, so a frame doesn't hold up everything else
+static const size_t ESP32_CAMERA_WINDOW_SIZE = 16384;
+#endif
 
 APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *parent)
     : parent_(parent), initial_state_iterator_(this), list_entities_iterator_(this) {
@@ -38,6 +44,11 @@ APIConnection::APIConnection(std::unique_ptr<socket::Socket> sock, APIServer *pa
 #else
 #error "No frame helper defined"
 #endif
+
+#ifdef USE_ESP32_CAMERA
+  if (esp32_camera::global_esp32_camera != nullptr && !esp32_camera::global_esp32_camera->is_internal())
+    esp32_camera::global_esp32_camera->add_consumer(&this->image_consumer_);
+#endif
 }
 void APIConnection::start() {
   this->last_traffic_ = millis();
@@ -133,25 +144,7 @@ void APIConnection::loop() {
   }
 
 #ifdef USE_ESP32_CAMERA
-  if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
-    uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
-    // fixed32 key = 1;
-    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
-    // bytes data = 2;
-    buffer.encode_bytes(2, this->image_reader_.peek_data_buffer(), to_send);
-    // bool done = 3;
-    bool done = this->image_reader_.available() == to_send;
-    buffer.encode_bool(3, done);
-    bool success = this->send_buffer(buffer, 44);
-
-    if (success) {
-      this->image_reader_.consume_data(to_send);
-    }
-    if (success && done) {
-      this->image_reader_.return_image();
-    }
-  }
+  this->send_camera_image_();
 #endif
 
   if (state_subs_at_ != -1) {
@@ -856,14 +849,52 @@ void APIConnection::media_player_command(const MediaPlayerCommandRequest &msg) {
 #endif
 
 #ifdef USE_ESP32_CAMERA
-void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage> image) {
-  if (!this->state_subscription_)
-    return;
-  if (this->image_reader_.available())
-    return;
-  if (image->was_requested_by(esphome::esp32_camera::API_REQUESTER) ||
-      image->was_requested_by(esphome::esp32_camera::IDLE))
+void APIConnection::send_camera_image_() {
+  if (!this->image_reader_.available()) {
+    auto image = this->image_consumer_.take();
+    if (!image)
+      return;
     this->image_reader_.set_image(std::move(image));
+    this->image_send_start_ = millis();
+  }
+
+  // Keep sending chunks while the socket takes them, up to the window, instead of one chunk per loop
+  size_t window = ESP32_CAMERA_WINDOW_SIZE;
+  while (window > 0 && this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
+    const size_t to_send = std::min({ESP32_CAMERA_CHUNK_SIZE, this->image_reader_.available(), window});
+    const bool done = this->image_reader_.available() == to_send;
+
+    // CameraImageResponse is encoded around the image data, which is written straight from the frame buffer
+    auto buffer = this->create_buffer();
+    // fixed32 key = 1;
+    buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
+    // bytes data = 2;
+    buffer.encode_field_raw(2, 2);
+    buffer.encode_varint_raw(to_send);
+    const size_t prefix_len = this->proto_write_buffer_.size();
+    // bool done = 3;
+    buffer.encode_bool(3, done);
+
+    struct iovec parts[3];
+    parts[0].iov_base = this->proto_write_buffer_.data();
+    parts[0].iov_len = prefix_len;
+    parts[1].iov_base = this->image_reader_.peek_data_buffer();
+    parts[1].iov_len = to_send;
+    parts[2].iov_base = this->proto_write_buffer_.data() + prefix_len;
+    parts[2].iov_len = this->proto_write_buffer_.size() - prefix_len;
+    if (!this->write_packet_(44, parts, 3))
+      return;
+
+    this->image_reader_.consume_data(to_send);
+    window -= to_send;
+    if (done) {
+      const auto &image = this->image_reader_.get_image();
+      ESP_LOGV(TAG, "%s: Sent camera image of %u bytes in %" PRIu32 "ms", this->client_combined_info_.c_str(),
+               image->get_data_length(), millis() - this->image_send_start_);
+      this->image_consumer_.frame_sent(*image);
+      this->image_reader_.return_image();
+    }
+  }
 }
 bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
   ListEntitiesCameraResponse msg;
@@ -1180,7 +1211,13 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  struct iovec part;
+  part.iov_base = buffer.get_buffer()->data();
+  part.iov_len = buffer.get_buffer()->size();
+  return this->write_packet_(message_type, &part, 1);
+}
+bool APIConnection::write_packet_(uint32_t message_type, const struct iovec *parts, int count) {
+  APIError err = this->helper_->write_packet_parts(message_type, parts, count);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
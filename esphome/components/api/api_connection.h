@@ -58,7 +58,6 @@ class APIConnection : public APIServerConnection {
   bool send_text_sensor_info(text_sensor::TextSensor *text_sensor);
 #endif
 #ifdef USE_ESP32_CAMERA
-  void send_camera_state(std::shared_ptr<esp32_camera::CameraImage> image);
   bool send_camera_info(esp32_camera::ESP32Camera *camera);
   void camera_image(const CameraImageRequest &msg) override;
 #endif
@@ -155,6 +154,9 @@ class APIConnection : public APIServerConnection {
   void subscribe_states(const SubscribeStatesRequest &msg) override {
     this->state_subscription_ = true;
     this->initial_state_iterator_.begin();
+#ifdef USE_ESP32_CAMERA
+    this->image_consumer_.set_active(true);
+#endif
   }
   void subscribe_logs(const SubscribeLogsRequest &msg) override {
     this->log_subscription_ = msg.level;
@@ -191,6 +193,11 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  /// Write a packet whose payload is made of several parts, returns false if it couldn't be written.
+  bool write_packet_(uint32_t message_type, const struct iovec *parts, int count);
+#ifdef USE_ESP32_CAMERA
+  void send_camera_image_();
+#endif
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -211,7 +218,9 @@ class APIConnection : public APIServerConnection {
   uint32_t client_api_version_major_{0};
   uint32_t client_api_version_minor_{0};
 #ifdef USE_ESP32_CAMERA
+  esp32_camera::CameraImageConsumer image_consumer_{"api", esp32_camera::API_REQUESTER, true};
   esp32_camera::CameraImageReader image_reader_;
+  uint32_t image_send_start_{0};
 #endif
 
   bool state_subscription_{false};
@@ -467,7 +467,7 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APINoiseFrameHelper::write_packet_parts(uint16_t type, const struct iovec *parts, int count) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,6 +479,10 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
+  size_t payload_len = 0;
+  for (int i = 0; i < count; i++)
+    payload_len += parts[i].iov_len;
+
   size_t padding = 0;
   size_t msg_len = 4 + payload_len + padding;
   size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
@@ -496,8 +500,12 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   tmpbuf[msg_offset + 1] = (uint8_t) type;
   tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
   tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
+  // copy data, the parts are encrypted in place
+  uint8_t *dest = &tmpbuf[payload_offset];
+  for (int i = 0; i < count; i++) {
+    const auto *part = reinterpret_cast<const uint8_t *>(parts[i].iov_base);
+    dest = std::copy(part, part + parts[i].iov_len, dest);
+  }
   // fill padding with zeros
   std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
 
@@ -903,26 +911,34 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   return APIError::OK;
 }
 bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+APIError APIPlaintextFrameHelper::write_packet_parts(uint16_t type, const struct iovec *parts, int count) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
+  if (count > MAX_PACKET_PARTS) {
+    return APIError::BAD_ARG;
+  }
+
+  size_t payload_len = 0;
+  for (int i = 0; i < count; i++)
+    payload_len += parts[i].iov_len;
 
   std::vector<uint8_t> header;
   header.push_back(0x00);
   ProtoVarInt(payload_len).encode(header);
   ProtoVarInt(type).encode(header);
 
-  struct iovec iov[2];
+  // the payload is written straight from the parts, they are only copied if the socket can't take them right away
+  struct iovec iov[1 + MAX_PACKET_PARTS];
   iov[0].iov_base = &header[0];
   iov[0].iov_len = header.size();
-  if (payload_len == 0) {
-    return write_raw_(iov, 1);
+  int iovcnt = 1;
+  for (int i = 0; i < count; i++) {
+    if (parts[i].iov_len != 0)
+      iov[iovcnt++] = parts[i];
   }
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
 
-  return write_raw_(iov, 2);
+  return write_raw_(iov, iovcnt);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
   // try send from tx_buf
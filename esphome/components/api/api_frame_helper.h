@@ -58,6 +58,9 @@ enum class APIError : int {
 
 const char *api_error_to_str(APIError err);
 
+/// Maximum number of parts a packet payload can be written from.
+static const int MAX_PACKET_PARTS = 4;
+
 class APIFrameHelper {
  public:
   virtual ~APIFrameHelper() = default;
@@ -65,7 +68,14 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  APIError write_packet(uint16_t type, const uint8_t *data, size_t len) {
+    struct iovec part;
+    part.iov_base = const_cast<uint8_t *>(data);
+    part.iov_len = len;
+    return this->write_packet_parts(type, &part, 1);
+  }
+  /// Write a packet whose payload is the concatenation of the parts, without first copying them into one buffer.
+  virtual APIError write_packet_parts(uint16_t type, const struct iovec *parts, int count) = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
@@ -84,7 +94,7 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_packet_parts(uint16_t type, const struct iovec *parts, int count) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -147,7 +157,7 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  APIError write_packet_parts(uint16_t type, const struct iovec *parts, int count) override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
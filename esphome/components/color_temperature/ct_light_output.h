@@ -20,11 +20,15 @@ class CTLightOutput : public light::LightOutput {
     traits.set_max_mireds(this->warm_white_temperature_);
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override {
+    return this->color_temperature_->supports_fade() && this->brightness_->supports_fade();
+  }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float color_temperature, brightness;
     state->current_values_as_ct(&color_temperature, &brightness);
-    this->color_temperature_->set_level(color_temperature);
-    this->brightness_->set_level(brightness);
+    this->color_temperature_->set_level(color_temperature, length);
+    this->brightness_->set_level(brightness, length);
   }
 
  protected:
@@ -21,11 +21,13 @@ class CWWWLightOutput : public light::LightOutput {
     traits.set_max_mireds(this->warm_white_temperature_);
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override { return this->cold_white_->supports_fade() && this->warm_white_->supports_fade(); }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float cwhite, wwhite;
     state->current_values_as_cwww(&cwhite, &wwhite, this->constant_brightness_);
-    this->cold_white_->set_level(cwhite);
-    this->warm_white_->set_level(wwhite);
+    this->cold_white_->set_level(cwhite, length);
+    this->warm_white_->set_level(wwhite, length);
   }
 
  protected:
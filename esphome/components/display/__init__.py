@@ -190,3 +190,37 @@ async def display_is_displaying_page_to_code(config, condition_id, template_arg,
 @coroutine_with_priority(100.0)
 async def to_code(config):
     cg.add_global(display_ns.using)
+
+
+def rle_encode(data, unit_size=1):
+    """Run-length encode data in units of unit_size bytes, see display::rle_decode()."""
+    units = [
+        tuple(data[pos : pos + unit_size]) for pos in range(0, len(data), unit_size)
+    ]
+    # A run of a single byte only pays off from three repetitions
+    min_run = 2 if unit_size > 1 else 3
+    encoded = []
+    literal = []
+
+    def flush_literal():
+        for start in range(0, len(literal), 128):
+            chunk = literal[start : start + 128]
+            encoded.append(len(chunk) - 1)
+            for unit in chunk:
+                encoded.extend(unit)
+        literal.clear()
+
+    pos = 0
+    while pos < len(units):
+        run = 1
+        while pos + run < len(units) and run < 128 and units[pos + run] == units[pos]:
+            run += 1
+        if run >= min_run:
+            flush_literal()
+            encoded.append(0x80 | (run - 1))
+            encoded.extend(units[pos])
+        else:
+            literal.extend(units[pos : pos + run])
+        pos += run
+    flush_literal()
+    return encoded
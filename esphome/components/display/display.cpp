@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -12,6 +13,21 @@ static const char *const TAG = "display";
 const Color COLOR_OFF(0, 0, 0, 0);
 const Color COLOR_ON(255, 255, 255, 255);
 
+static int bitmap_bytes_per_pixel(BitmapFormat format) {
+  switch (format) {
+    case BITMAP_GRAYSCALE:
+      return 1;
+    case BITMAP_RGB565:
+      return 2;
+    case BITMAP_RGB24:
+      return 3;
+    case BITMAP_RGBA:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
 void Display::fill(Color color) { this->filled_rectangle(0, 0, this->get_width(), this->get_height(), color); }
 void Display::clear() { this->fill(COLOR_OFF); }
 void Display::set_rotation(DisplayRotation rotation) { this->rotation_ = rotation; }
@@ -36,14 +52,10 @@ void HOT Display::line(int x1, int y1, int x2, int y2, Color color) {
   }
 }
 void HOT Display::horizontal_line(int x, int y, int width, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = x; i < x + width; i++)
-    this->draw_pixel_at(i, y, color);
+  this->filled_rectangle(x, y, width, 1, color);
 }
 void HOT Display::vertical_line(int x, int y, int height, Color color) {
-  // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
-  for (int i = y; i < y + height; i++)
-    this->draw_pixel_at(x, i, color);
+  this->filled_rectangle(x, y, 1, height, color);
 }
 void Display::rectangle(int x1, int y1, int width, int height, Color color) {
   this->horizontal_line(x1, y1, width, color);
@@ -52,10 +64,108 @@ void Display::rectangle(int x1, int y1, int width, int height, Color color) {
   this->vertical_line(x1 + width - 1, y1, height, color);
 }
 void Display::filled_rectangle(int x1, int y1, int width, int height, Color color) {
-  // Future: Use vertical_line and horizontal_line methods depending on rotation to reduce memory accesses.
-  for (int i = y1; i < y1 + height; i++) {
-    this->horizontal_line(x1, i, width, color);
+  int min_x, max_x, min_y, max_y;
+  if (!this->clamp_x_(x1, width, min_x, max_x) || !this->clamp_y_(y1, height, min_y, max_y))
+    return;
+  this->fill_rect_(min_x, min_y, max_x - min_x, max_y - min_y, color);
+}
+void HOT Display::draw_bitmap(int x, int y, int width, int height, const uint8_t *data, BitmapFormat format,
+                              Color color_on, Color color_off, bool transparent) {
+  int min_x, max_x, min_y, max_y;
+  if (!this->clamp_x_(x, width, min_x, max_x) || !this->clamp_y_(y, height, min_y, max_y))
+    return;
+
+  if (format == BITMAP_BINARY) {
+    // Runs of equal bits are filled with a single color, each byte of the bitmap is only read once
+    const int stride = (width + 7) / 8;
+    for (int row_y = min_y; row_y < max_y; row_y++) {
+      const uint8_t *row = data + (row_y - y) * stride;
+      int run_start = min_x;
+      bool run_on = false;
+      uint8_t bits = 0;
+      for (int px = min_x; px < max_x; px++) {
+        const int bit = px - x;
+        if (bit % 8 == 0 || px == min_x) {
+          bits = progmem_read_byte(row + bit / 8);
+          if (bits == 0 && transparent && !run_on && bit % 8 == 0 && px + 8 <= max_x) {
+            // nothing to draw in this byte
+            px += 7;
+            run_start = px + 1;
+            continue;
+          }
+        }
+        const bool on = bits & (0x80 >> (bit % 8));
+        if (on == run_on)
+          continue;
+        if (px != run_start && (run_on || !transparent))
+          this->fill_rect_(run_start, row_y, px - run_start, 1, run_on ? color_on : color_off);
+        run_start = px;
+        run_on = on;
+      }
+      if (max_x != run_start && (run_on || !transparent))
+        this->fill_rect_(run_start, row_y, max_x - run_start, 1, run_on ? color_on : color_off);
+    }
+    return;
   }
+
+  // Other formats are decoded into a chunk of colors, runs of visible pixels are drawn as spans
+  static const int CHUNK_SIZE = 32;
+  Color colors[CHUNK_SIZE];
+  const int bytes_per_pixel = bitmap_bytes_per_pixel(format);
+  for (int row_y = min_y; row_y < max_y; row_y++) {
+    const uint8_t *pixel = data + ((row_y - y) * width + (min_x - x)) * bytes_per_pixel;
+    int len = 0;
+    for (int px = min_x; px < max_x; px++, pixel += bytes_per_pixel) {
+      Color color;
+      bool visible = true;
+      switch (format) {
+        case BITMAP_GRAYSCALE: {
+          const uint8_t gray = progmem_read_byte(pixel);
+          color = Color(gray, gray, gray, 0xFF);
+          visible = !transparent || gray != 1;
+          break;
+        }
+        case BITMAP_RGB565: {
+          const uint16_t rgb565 = progmem_read_byte(pixel) << 8 | progmem_read_byte(pixel + 1);
+          const uint8_t r = (rgb565 & 0xF800) >> 11;
+          const uint8_t g = (rgb565 & 0x07E0) >> 5;
+          const uint8_t b = rgb565 & 0x001F;
+          color = Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 0xFF);
+          visible = !transparent || rgb565 != 0x0020;
+          break;
+        }
+        case BITMAP_RGB24:
+          color = Color(progmem_read_byte(pixel), progmem_read_byte(pixel + 1), progmem_read_byte(pixel + 2), 0xFF);
+          visible = !transparent || color.b != 1 || color.r != 0 || color.g != 0;
+          break;
+        default:
+          color = Color(progmem_read_byte(pixel), progmem_read_byte(pixel + 1), progmem_read_byte(pixel + 2),
+                        progmem_read_byte(pixel + 3));
+          visible = color.w >= 0x80;
+          break;
+      }
+      if (visible)
+        colors[len++] = color;
+      if (len != 0 && (!visible || len == CHUNK_SIZE)) {
+        // flush the run up to and including this pixel if visible, otherwise the run before it
+        const int end = visible ? px + 1 : px;
+        this->draw_span_(end - len, row_y, colors, len);
+        len = 0;
+      }
+    }
+    if (len != 0)
+      this->draw_span_(max_x - len, row_y, colors, len);
+  }
+}
+void Display::fill_rect_(int x, int y, int width, int height, Color color) {
+  for (int i = y; i < y + height; i++) {
+    for (int j = x; j < x + width; j++)
+      this->draw_pixel_at(j, i, color);
+  }
+}
+void Display::draw_span_(int x, int y, const Color *colors, int len) {
+  for (int i = 0; i < len; i++)
+    this->draw_pixel_at(x + i, y, colors[i]);
 }
 void HOT Display::circle(int center_x, int center_xy, int radius, Color color) {
   int dx = -radius;
@@ -87,10 +197,6 @@ void Display::filled_circle(int center_x, int center_y, int radius, Color color)
   int e2;
 
   do {
-    this->draw_pixel_at(center_x - dx, center_y + dy, color);
-    this->draw_pixel_at(center_x + dx, center_y + dy, color);
-    this->draw_pixel_at(center_x + dx, center_y - dy, color);
-    this->draw_pixel_at(center_x - dx, center_y - dy, color);
     int hline_width = 2 * (-dx) + 1;
     this->horizontal_line(center_x + dx, center_y + dy, hline_width, color);
     this->horizontal_line(center_x + dx, center_y - dy, hline_width, color);
@@ -132,6 +132,15 @@ enum DisplayRotation {
   DISPLAY_ROTATION_270_DEGREES = 270,
 };
 
+/// Pixel formats of the bitmaps drawn with Display::draw_bitmap().
+enum BitmapFormat : uint8_t {
+  BITMAP_BINARY = 0,     ///< 1 bit per pixel, most significant bit first, each row starts at a new byte
+  BITMAP_GRAYSCALE = 1,  ///< 8 bits per pixel, a gray level of 1 is transparent
+  BITMAP_RGB565 = 2,     ///< 16 bits per pixel, big endian, 0x0020 is transparent
+  BITMAP_RGB24 = 3,      ///< 24 bits per pixel, (0, 0, 1) is transparent
+  BITMAP_RGBA = 4,       ///< 32 bits per pixel, pixels with an alpha below 0x80 are transparent
+};
+
 class Display;
 class DisplayPage;
 class DisplayOnPageChangeTrigger;
@@ -197,6 +206,20 @@ class Display {
   /// Fill a rectangle with the top left point at [x1,y1] and the bottom right point at [x1+width,y1+height].
   void filled_rectangle(int x1, int y1, int width, int height, Color color = COLOR_ON);
 
+  /** Draw a bitmap with the top left point at [x,y].
+   *
+   * The bitmap is clipped once and then drawn row by row in spans, instead of pixel by pixel.
+   *
+   * @param data The pixel data, which may be stored in flash.
+   * @param format The pixel format of the data.
+   * @param color_on The color of set pixels in binary bitmaps.
+   * @param color_off The color of cleared pixels in binary bitmaps.
+   * @param transparent Whether cleared pixels of binary bitmaps and the transparent color of the other formats are
+   *                    skipped.
+   */
+  void draw_bitmap(int x, int y, int width, int height, const uint8_t *data, BitmapFormat format,
+                   Color color_on = COLOR_ON, Color color_off = COLOR_OFF, bool transparent = false);
+
   /// Draw the outline of a circle centered around [center_x,center_y] with the radius radius with the given color.
   void circle(int center_x, int center_xy, int radius, Color color = COLOR_ON);
 
@@ -481,6 +504,13 @@ class Display {
   bool clip(int x, int y);
 
  protected:
+  /// Fill a rectangle that lies within the display and the clipping region. The default draws each pixel.
+  virtual void fill_rect_(int x, int y, int width, int height, Color color);
+  /// Draw a horizontal run of pixels that lies within the display and the clipping region. The default draws each
+  /// pixel.
+  virtual void draw_span_(int x, int y, const Color *colors, int len);
+
+  /// Clamp a span to the display and the clipping rectangle, max_x and max_y are exclusive like Rect::x2().
   bool clamp_x_(int x, int w, int &min_x, int &max_x);
   bool clamp_y_(int y, int h, int &min_y, int &max_y);
   void vprintf_(int x, int y, BaseFont *font, Color color, TextAlign align, const char *format, va_list arg);
@@ -68,5 +68,67 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::fill_rect_(int x, int y, int width, int height, Color color) {
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      x = this->get_width_internal() - x - width;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = this->get_width_internal() - x - width;
+      y = this->get_height_internal() - y - height;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      std::swap(x, y);
+      std::swap(width, height);
+      y = this->get_height_internal() - y - height;
+      break;
+  }
+  this->fill_absolute_rect_internal(x, y, width, height, color);
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::draw_span_(int x, int y, const Color *colors, int len) {
+  int dx = 1, dy = 0;
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      std::swap(x, y);
+      x = this->get_width_internal() - x - 1;
+      dx = 0;
+      dy = 1;
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      x = this->get_width_internal() - x - 1;
+      y = this->get_height_internal() - y - 1;
+      dx = -1;
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      std::swap(x, y);
+      y = this->get_height_internal() - y - 1;
+      dx = 0;
+      dy = -1;
+      break;
+  }
+  this->draw_absolute_span_internal(x, y, dx, dy, colors, len);
+  App.feed_wdt();
+}
+
+void HOT DisplayBuffer::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  for (int i = y; i < y + height; i++) {
+    for (int j = x; j < x + width; j++)
+      this->draw_absolute_pixel_internal(j, i, color);
+  }
+}
+
+void HOT DisplayBuffer::draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) {
+  for (int i = 0; i < len; i++, x += dx, y += dy)
+    this->draw_absolute_pixel_internal(x, y, colors[i]);
+}
+
 }  // namespace display
 }  // namespace esphome
@@ -27,6 +27,13 @@ class DisplayBuffer : public Display {
 
  protected:
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
+  /// Fill a rectangle in unrotated coordinates, drivers can override this to write to their buffer directly.
+  virtual void fill_absolute_rect_internal(int x, int y, int width, int height, Color color);
+  /// Draw a run of pixels in unrotated coordinates, starting at [x,y] and moving by [dx,dy] after each pixel.
+  virtual void draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len);
+
+  void fill_rect_(int x, int y, int width, int height, Color color) override;
+  void draw_span_(int x, int y, const Color *colors, int len) override;
 
   void init_internal_(uint32_t buffer_length);
 
@@ -69,9 +69,9 @@ bool Rect::inside(int16_t test_x, int16_t test_y, bool absolute) const {  // NOL
     return true;
   }
   if (absolute) {
-    return ((test_x >= this->x) && (test_x <= this->x2()) && (test_y >= this->y) && (test_y <= this->y2()));
+    return ((test_x >= this->x) && (test_x < this->x2()) && (test_y >= this->y) && (test_y < this->y2()));
   } else {
-    return ((test_x >= 0) && (test_x <= this->w) && (test_y >= 0) && (test_y <= this->h));
+    return ((test_x >= 0) && (test_x < this->w) && (test_y >= 0) && (test_y < this->h));
   }
 }
 
@@ -80,9 +80,9 @@ bool Rect::inside(Rect rect, bool absolute) const {
     return true;
   }
   if (absolute) {
-    return ((rect.x <= this->x2()) && (rect.x2() >= this->x) && (rect.y <= this->y2()) && (rect.y2() >= this->y));
+    return ((rect.x < this->x2()) && (rect.x2() > this->x) && (rect.y < this->y2()) && (rect.y2() > this->y));
   } else {
-    return ((rect.x <= this->w) && (rect.w >= 0) && (rect.y <= this->h) && (rect.h >= 0));
+    return ((rect.x < this->w) && (rect.x2() > 0) && (rect.y < this->h) && (rect.y2() > 0));
   }
 }
 
@@ -16,8 +16,8 @@ class Rect {
 
   Rect() : x(VALUE_NO_SET), y(VALUE_NO_SET), w(VALUE_NO_SET), h(VALUE_NO_SET) {}  // NOLINT
   inline Rect(int16_t x, int16_t y, int16_t w, int16_t h) ALWAYS_INLINE : x(x), y(y), w(w), h(h) {}
-  inline int16_t x2() const { return this->x + this->w; };  ///< X coordinate of corner
-  inline int16_t y2() const { return this->y + this->h; };  ///< Y coordinate of corner
+  inline int16_t x2() const { return this->x + this->w; };  ///< X coordinate of corner, just outside of the region
+  inline int16_t y2() const { return this->y + this->h; };  ///< Y coordinate of corner, just outside of the region
 
   inline bool is_set() const ALWAYS_INLINE { return (this->h != VALUE_NO_SET) && (this->w != VALUE_NO_SET); }
 
@@ -26,7 +26,9 @@ class Rect {
   void extend(Rect rect);
   void shrink(Rect rect);
 
+  /// Whether the regions overlap
   bool inside(Rect rect, bool absolute = true) const;
+  /// Whether the pixel is in the region, which ends before x2() and y2()
   bool inside(int16_t test_x, int16_t test_y, bool absolute = true) const;
   bool equal(Rect rect) const;
   void info(const std::string &prefix = "rect info:");
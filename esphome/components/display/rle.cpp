@@ -0,0 +1,32 @@
+#include "rle.h"
+
+#include <algorithm>
+
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace display {
+
+const uint8_t *rle_decode(const uint8_t *src, uint8_t *dst, size_t units, size_t unit_size) {
+  while (units > 0) {
+    const uint8_t header = progmem_read_byte(src++);
+    const size_t count = std::min<size_t>((header & 0x7F) + 1, units);
+    units -= count;
+    if (header & 0x80) {
+      for (size_t i = 0; i < unit_size; i++)
+        dst[i] = progmem_read_byte(src + i);
+      for (size_t i = unit_size; i < count * unit_size; i++)
+        dst[i] = dst[i - unit_size];
+      src += unit_size;
+    } else {
+      for (size_t i = 0; i < count * unit_size; i++)
+        dst[i] = progmem_read_byte(src + i);
+      src += count * unit_size;
+    }
+    dst += count * unit_size;
+  }
+  return src;
+}
+
+}  // namespace display
+}  // namespace esphome
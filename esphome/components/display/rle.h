@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace display {
+
+/** Decode run-length encoded bitmap data stored in flash.
+ *
+ * The data is a sequence of packets made of units of unit_size bytes, e.g. one pixel. A header byte of 0x80 | (n - 1)
+ * is followed by a single unit that is repeated n times, a header byte of n - 1 is followed by n literal units.
+ *
+ * @param src The encoded data.
+ * @param dst Buffer receiving units * unit_size decoded bytes.
+ * @param units The number of units to decode.
+ * @param unit_size The size of a unit in bytes.
+ * @return The position in src after the last packet that was read.
+ */
+const uint8_t *rle_decode(const uint8_t *src, uint8_t *dst, size_t units, size_t unit_size);
+
+}  // namespace display
+}  // namespace esphome
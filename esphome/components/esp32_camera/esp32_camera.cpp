@@ -6,10 +6,14 @@
 
 #include <freertos/task.h>
 
+#include <algorithm>
+#include <cinttypes>
+
 namespace esphome {
 namespace esp32_camera {
 
 static const char *const TAG = "esp32_camera";
+static const uint32_t STATS_INTERVAL = 10000;
 
 /* ---------------- public API (derivated) ---------------- */
 void ESP32Camera::setup() {
@@ -32,7 +36,7 @@ void ESP32Camera::setup() {
 
   /* initialize RTOS */
   this->framebuffer_get_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
-  this->framebuffer_return_queue_ = xQueueCreate(1, sizeof(camera_fb_t *));
+  this->framebuffer_return_queue_ = xQueueCreate(this->config_.fb_count, sizeof(camera_fb_t *));
   xTaskCreatePinnedToCore(&ESP32Camera::framebuffer_task,
                           "framebuffer_task",  // name
                           1024,                // stack size
@@ -127,7 +131,7 @@ void ESP32Camera::dump_config() {
   sensor_t *s = esp_camera_sensor_get();
   auto st = s->status;
   ESP_LOGCONFIG(TAG, "  JPEG Quality: %u", st.quality);
-  // ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
+  ESP_LOGCONFIG(TAG, "  Framebuffer Count: %u", conf.fb_count);
   ESP_LOGCONFIG(TAG, "  Contrast: %d", st.contrast);
   ESP_LOGCONFIG(TAG, "  Brightness: %d", st.brightness);
   ESP_LOGCONFIG(TAG, "  Saturation: %d", st.saturation);
@@ -153,16 +157,16 @@ void ESP32Camera::dump_config() {
 }
 
 void ESP32Camera::loop() {
-  // check if we can return the image
-  if (this->can_return_image_()) {
-    // return image
-    auto *fb = this->current_image_->get_raw_buffer();
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    this->current_image_.reset();
+  // return the frames no consumer is using anymore
+  this->return_images_();
+
+  const uint32_t now = millis();
+  if (now - this->last_stats_ > STATS_INTERVAL) {
+    this->last_stats_ = now;
+    this->log_consumer_stats_();
   }
 
   // request idle image every idle_update_interval
-  const uint32_t now = millis();
   if (this->idle_update_interval_ != 0 && now - this->last_idle_request_ > this->idle_update_interval_) {
     this->last_idle_request_ = now;
     this->request_image(IDLE);
@@ -171,8 +175,8 @@ void ESP32Camera::loop() {
   // Check if we should fetch a new image
   if (!this->has_requested_image_())
     return;
-  if (this->current_image_.use_count() > 1) {
-    // image is still in use
+  if (this->images_.size() >= this->config_.fb_count) {
+    // all frame buffers are still in use
     return;
   }
   if (now - this->last_update_ <= this->max_update_interval_)
@@ -186,15 +190,13 @@ void ESP32Camera::loop() {
     return;
   }
 
-  if (fb == nullptr) {
-    ESP_LOGW(TAG, "Got invalid frame from camera!");
-    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
-    return;
-  }
-  this->current_image_ = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  auto image = std::make_shared<CameraImage>(fb, this->single_requesters_ | this->stream_requesters_);
+  this->images_.push_back(image);
 
   ESP_LOGD(TAG, "Got Image: len=%u", fb->len);
-  this->new_image_callback_.call(this->current_image_);
+  for (auto *consumer : this->consumers_)
+    consumer->offer(image);
+  this->new_image_callback_.call(image);
   this->last_update_ = now;
   this->single_requesters_ = 0;
 }
@@ -333,11 +335,18 @@ void ESP32Camera::set_max_update_interval(uint32_t max_update_interval) {
 void ESP32Camera::set_idle_update_interval(uint32_t idle_update_interval) {
   this->idle_update_interval_ = idle_update_interval;
 }
+/* set frame buffers */
+void ESP32Camera::set_frame_buffer_count(uint8_t frame_buffer_count) { this->config_.fb_count = frame_buffer_count; }
 
 /* ---------------- public API (specific) ---------------- */
 void ESP32Camera::add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&f) {
   this->new_image_callback_.add(std::move(f));
 }
+void ESP32Camera::add_consumer(CameraImageConsumer *consumer) { this->consumers_.push_back(consumer); }
+void ESP32Camera::remove_consumer(CameraImageConsumer *consumer) {
+  this->consumers_.erase(std::remove(this->consumers_.begin(), this->consumers_.end(), consumer),
+                         this->consumers_.end());
+}
 void ESP32Camera::add_stream_start_callback(std::function<void()> &&callback) {
   this->stream_start_callback_.add(std::move(callback));
 }
@@ -379,14 +388,51 @@ void ESP32Camera::update_camera_parameters() {
 
 /* ---------------- Internal methods ---------------- */
 bool ESP32Camera::has_requested_image_() const { return this->single_requesters_ || this->stream_requesters_; }
-bool ESP32Camera::can_return_image_() const { return this->current_image_.use_count() == 1; }
+void ESP32Camera::return_images_() {
+  for (auto it = this->images_.begin(); it != this->images_.end();) {
+    if (it->use_count() > 1) {
+      // image is still in use
+      ++it;
+      continue;
+    }
+    auto *fb = (*it)->get_raw_buffer();
+    xQueueSend(this->framebuffer_return_queue_, &fb, portMAX_DELAY);
+    it = this->images_.erase(it);
+  }
+}
+void ESP32Camera::log_consumer_stats_() {
+  for (auto *consumer : this->consumers_) {
+    if (!consumer->is_active() || consumer->get_frames() == 0)
+      continue;
+    ESP_LOGD(TAG, "%s: %.1f fps, latency %" PRIu32 "ms, %" PRIu32 " frames sent, %" PRIu32 " dropped",
+             consumer->get_name(), consumer->get_fps(), consumer->get_latency(), consumer->get_frames(),
+             consumer->get_dropped_frames());
+  }
+}
 void ESP32Camera::framebuffer_task(void *pv) {
+  const uint8_t fb_count = global_esp32_camera->config_.fb_count;
+  uint8_t in_use = 0;
   while (true) {
-    camera_fb_t *framebuffer = esp_camera_fb_get();
+    camera_fb_t *framebuffer;
+    // give back the frames returned by the main loop, waiting for one when all frame buffers are in use
+    while (xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer,
+                         in_use >= fb_count ? portMAX_DELAY : 0) == pdTRUE) {
+      esp_camera_fb_return(framebuffer);
+      in_use--;
+    }
+
+    framebuffer = esp_camera_fb_get();
+    if (framebuffer == nullptr)
+      continue;
+    in_use++;
+
+    // drop the previous frame if the main loop hasn't picked it up, it only wants the newest one
+    camera_fb_t *previous;
+    if (xQueueReceive(global_esp32_camera->framebuffer_get_queue_, &previous, 0) == pdTRUE) {
+      esp_camera_fb_return(previous);
+      in_use--;
+    }
     xQueueSend(global_esp32_camera->framebuffer_get_queue_, &framebuffer, portMAX_DELAY);
-    // return is no-op for config with 1 fb
-    xQueueReceive(global_esp32_camera->framebuffer_return_queue_, &framebuffer, portMAX_DELAY);
-    esp_camera_fb_return(framebuffer);
   }
 }
 
@@ -407,8 +453,85 @@ void CameraImageReader::return_image() { this->image_.reset(); }
 void CameraImageReader::consume_data(size_t consumed) { this->offset_ += consumed; }
 uint8_t *CameraImageReader::peek_data_buffer() { return this->image_->get_data_buffer() + this->offset_; }
 
+/* ---------------- CameraImageConsumer class ---------------- */
+CameraImageConsumer::CameraImageConsumer(const char *name, CameraRequester requester, bool accept_idle)
+    : name_(name), requester_(requester), accept_idle_(accept_idle) {
+  this->semaphore_ = xSemaphoreCreateBinary();
+}
+CameraImageConsumer::~CameraImageConsumer() {
+  if (global_esp32_camera != nullptr)
+    global_esp32_camera->remove_consumer(this);
+  vSemaphoreDelete(this->semaphore_);
+}
+void CameraImageConsumer::set_active(bool active) {
+  this->active_ = active;
+  if (active) {
+    this->last_sent_ = 0;
+    this->frame_interval_ = 0;
+    return;
+  }
+  {
+    LockGuard guard(this->lock_);
+    this->pending_.reset();
+  }
+  // wake up a task waiting for a frame
+  xSemaphoreGive(this->semaphore_);
+}
+void CameraImageConsumer::offer(const std::shared_ptr<CameraImage> &image) {
+  if (!this->active_)
+    return;
+  if (!image->was_requested_by(this->requester_) && !(this->accept_idle_ && image->was_requested_by(IDLE)))
+    return;
+  {
+    LockGuard guard(this->lock_);
+    if (this->pending_)
+      this->dropped_++;
+    this->pending_ = image;
+  }
+  xSemaphoreGive(this->semaphore_);
+}
+std::shared_ptr<CameraImage> CameraImageConsumer::take() {
+  std::shared_ptr<CameraImage> image;
+  LockGuard guard(this->lock_);
+  image.swap(this->pending_);
+  return image;
+}
+std::shared_ptr<CameraImage> CameraImageConsumer::wait(uint32_t timeout) {
+  const uint32_t start = millis();
+  while (true) {
+    auto image = this->take();
+    if (image || !this->active_)
+      return image;
+    const uint32_t elapsed = millis() - start;
+    if (elapsed >= timeout)
+      return nullptr;
+    // the semaphore may also have been given for a frame that was taken already, so check again after waking up
+    xSemaphoreTake(this->semaphore_, (timeout - elapsed) / portTICK_PERIOD_MS);
+  }
+}
+void CameraImageConsumer::frame_sent(const CameraImage &image) {
+  const uint32_t now = millis();
+  const uint32_t latency = now - image.get_timestamp();
+  // moving averages over roughly the last eight frames
+  this->latency_ = this->frames_ == 0 ? latency : (this->latency_ * 7 + latency) / 8;
+  if (this->last_sent_ != 0) {
+    const uint32_t interval = now - this->last_sent_;
+    this->frame_interval_ = this->frame_interval_ == 0 ? interval : (this->frame_interval_ * 7 + interval) / 8;
+  }
+  this->last_sent_ = now;
+  this->frames_++;
+}
+float CameraImageConsumer::get_fps() const {
+  const uint32_t interval = this->frame_interval_;
+  return interval == 0 ? 0.0f : 1000.0f / interval;
+}
+
 /* ---------------- CameraImage class ---------------- */
-CameraImage::CameraImage(camera_fb_t *buffer, uint8_t requesters) : buffer_(buffer), requesters_(requesters) {}
+CameraImage::CameraImage(camera_fb_t *buffer, uint8_t requesters) : buffer_(buffer), requesters_(requesters) {
+  // the driver stamps the frame with esp_timer_get_time() during capture, the same clock millis() uses
+  const struct timeval &captured = buffer->timestamp;
+  this->timestamp_ = static_cast<uint32_t>(uint64_t(captured.tv_sec) * 1000 + captured.tv_usec / 1000);
+}
 
 camera_fb_t *CameraImage::get_raw_buffer() { return this->buffer_; }
 uint8_t *CameraImage::get_data_buffer() { return this->buffer_->buf; }
@@ -9,6 +9,11 @@
 #include <esp_camera.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <freertos/semphr.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 namespace esphome {
 namespace esp32_camera {
@@ -80,16 +85,77 @@ class CameraImage {
   uint8_t *get_data_buffer();
   size_t get_data_length();
   bool was_requested_by(CameraRequester requester) const;
+  /// Time in milliseconds (on the millis() clock) when the camera captured the frame.
+  uint32_t get_timestamp() const { return this->timestamp_; }
 
  protected:
   camera_fb_t *buffer_;
   uint8_t requesters_;
+  uint32_t timestamp_;
+};
+
+/* ---------------- CameraImageConsumer class ---------------- */
+/** A consumer of camera frames that sends them at its own pace.
+ *
+ * The camera offers every new frame to all active consumers. A consumer holds on to the newest frame it hasn't taken
+ * yet; when another frame arrives before that, the older one is dropped. So a slow consumer only skips frames and
+ * never holds back the camera or the other consumers, as long as there are enough frame buffers.
+ *
+ * Frames are offered from the main loop and may be taken from another task.
+ */
+class CameraImageConsumer {
+ public:
+  /**
+   * @param name The name used when logging the statistics of this consumer.
+   * @param requester The requester whose frames this consumer receives.
+   * @param accept_idle Whether this consumer also receives the frames taken every idle update interval.
+   */
+  CameraImageConsumer(const char *name, CameraRequester requester, bool accept_idle = false);
+  ~CameraImageConsumer();
+
+  /// Start or stop receiving frames, stopping drops the frame that wasn't taken yet.
+  void set_active(bool active);
+  bool is_active() const { return this->active_; }
+
+  /// Offer a new frame, replacing the one that wasn't taken yet.
+  void offer(const std::shared_ptr<CameraImage> &image);
+  /// Take the newest frame, or nullptr if there is none.
+  std::shared_ptr<CameraImage> take();
+  /// Take the newest frame, waiting up to timeout milliseconds for one to arrive.
+  std::shared_ptr<CameraImage> wait(uint32_t timeout);
+  /// Record that a frame taken from this consumer was sent completely.
+  void frame_sent(const CameraImage &image);
+
+  const char *get_name() const { return this->name_; }
+  uint32_t get_frames() const { return this->frames_; }
+  uint32_t get_dropped_frames() const { return this->dropped_; }
+  /// Average rate of sent frames.
+  float get_fps() const;
+  /// Average time in milliseconds from taking a frame from the camera until it was sent.
+  uint32_t get_latency() const { return this->latency_; }
+
+ protected:
+  const char *name_;
+  CameraRequester requester_;
+  bool accept_idle_;
+  std::atomic<bool> active_{false};
+
+  Mutex lock_;
+  SemaphoreHandle_t semaphore_;
+  std::shared_ptr<CameraImage> pending_;
+
+  std::atomic<uint32_t> frames_{0};
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> latency_{0};
+  std::atomic<uint32_t> frame_interval_{0};
+  uint32_t last_sent_{0};
 };
 
 /* ---------------- CameraImageReader class ---------------- */
 class CameraImageReader {
  public:
   void set_image(std::shared_ptr<CameraImage> image);
+  const std::shared_ptr<CameraImage> &get_image() const { return this->image_; }
   size_t available() const;
   uint8_t *peek_data_buffer();
   void consume_data(size_t consumed);
@@ -140,6 +206,8 @@ class ESP32Camera : public Component, public EntityBase {
   /* -- framerates */
   void set_max_update_interval(uint32_t max_update_interval);
   void set_idle_update_interval(uint32_t idle_update_interval);
+  /* -- frame buffers */
+  void set_frame_buffer_count(uint8_t frame_buffer_count);
 
   /* public API (derivated) */
   void setup() override;
@@ -148,6 +216,8 @@ class ESP32Camera : public Component, public EntityBase {
   float get_setup_priority() const override;
   /* public API (specific) */
   void add_image_callback(std::function<void(std::shared_ptr<CameraImage>)> &&f);
+  void add_consumer(CameraImageConsumer *consumer);
+  void remove_consumer(CameraImageConsumer *consumer);
   void start_stream(CameraRequester requester);
   void stop_stream(CameraRequester requester);
   void request_image(CameraRequester requester);
@@ -159,7 +229,8 @@ class ESP32Camera : public Component, public EntityBase {
  protected:
   /* internal methods */
   bool has_requested_image_() const;
-  bool can_return_image_() const;
+  void return_images_();
+  void log_consumer_stats_();
 
   static void framebuffer_task(void *pv);
 
@@ -191,7 +262,9 @@ class ESP32Camera : public Component, public EntityBase {
   uint32_t idle_update_interval_{15000};
 
   esp_err_t init_error_{ESP_OK};
-  std::shared_ptr<CameraImage> current_image_;
+  /// Frames handed out to consumers, returned to the camera once no consumer uses them anymore
+  std::vector<std::shared_ptr<CameraImage>> images_;
+  std::vector<CameraImageConsumer *> consumers_;
   uint8_t single_requesters_{0};
   uint8_t stream_requesters_{0};
   QueueHandle_t framebuffer_get_queue_;
@@ -202,6 +275,7 @@ class ESP32Camera : public Component, public EntityBase {
 
   uint32_t last_idle_request_{0};
   uint32_t last_update_{0};
+  uint32_t last_stats_{0};
 };
 
 // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
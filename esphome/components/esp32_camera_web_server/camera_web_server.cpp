@@ -45,8 +45,6 @@ void CameraWebServer::setup() {
     return;
   }
 
-  this->semaphore_ = xSemaphoreCreateBinary();
-
   httpd_config_t config = HTTPD_DEFAULT_CONFIG();
   config.server_port = this->port_;
   config.ctrl_port = this->port_;
@@ -67,21 +65,14 @@ void CameraWebServer::setup() {
 
   httpd_register_uri_handler(this->httpd_, &uri);
 
-  esp32_camera::global_esp32_camera->add_image_callback([this](std::shared_ptr<esp32_camera::CameraImage> image) {
-    if (this->running_ && image->was_requested_by(esp32_camera::WEB_REQUESTER)) {
-      this->image_ = std::move(image);
-      xSemaphoreGive(this->semaphore_);
-    }
-  });
+  esp32_camera::global_esp32_camera->add_consumer(&this->consumer_);
 }
 
 void CameraWebServer::on_shutdown() {
   this->running_ = false;
-  this->image_ = nullptr;
+  this->consumer_.set_active(false);
   httpd_stop(this->httpd_);
   this->httpd_ = nullptr;
-  vSemaphoreDelete(this->semaphore_);
-  this->semaphore_ = nullptr;
 }
 
 void CameraWebServer::dump_config() {
@@ -100,30 +91,11 @@ void CameraWebServer::dump_config() {
 
 float CameraWebServer::get_setup_priority() const { return setup_priority::LATE; }
 
-void CameraWebServer::loop() {
-  if (!this->running_) {
-    this->image_ = nullptr;
-  }
-}
-
-std::shared_ptr<esphome::esp32_camera::CameraImage> CameraWebServer::wait_for_image_() {
-  std::shared_ptr<esphome::esp32_camera::CameraImage> image;
-  image.swap(this->image_);
-
-  if (!image) {
-    // retry as we might still be fetching image
-    xSemaphoreTake(this->semaphore_, IMAGE_REQUEST_TIMEOUT / portTICK_PERIOD_MS);
-    image.swap(this->image_);
-  }
-
-  return image;
-}
-
 esp_err_t CameraWebServer::handler_(struct httpd_req *req) {
   esp_err_t res = ESP_FAIL;
 
-  this->image_ = nullptr;
   this->running_ = true;
+  this->consumer_.set_active(true);
 
   switch (this->mode_) {
     case STREAM:
@@ -136,7 +108,7 @@ esp_err_t CameraWebServer::handler_(struct httpd_req *req) {
   }
 
   this->running_ = false;
-  this->image_ = nullptr;
+  this->consumer_.set_active(false);
   return res;
 }
 
@@ -173,7 +145,7 @@ esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
   esp32_camera::global_esp32_camera->start_stream(esphome::esp32_camera::WEB_REQUESTER);
 
   while (res == ESP_OK && this->running_) {
-    auto image = this->wait_for_image_();
+    auto image = this->consumer_.wait(IMAGE_REQUEST_TIMEOUT);
 
     if (!image) {
       ESP_LOGW(TAG, "STREAM: failed to acquire frame");
@@ -190,6 +162,7 @@ esp_err_t CameraWebServer::streaming_handler_(struct httpd_req *req) {
       res = httpd_send_all(req, STREAM_BOUNDARY, strlen(STREAM_BOUNDARY));
     }
     if (res == ESP_OK) {
+      this->consumer_.frame_sent(*image);
       frames++;
       int64_t frame_time = millis() - last_frame;
       last_frame = millis();
@@ -215,7 +188,7 @@ esp_err_t CameraWebServer::snapshot_handler_(struct httpd_req *req) {
 
   esp32_camera::global_esp32_camera->request_image(esphome::esp32_camera::WEB_REQUESTER);
 
-  auto image = this->wait_for_image_();
+  auto image = this->consumer_.wait(IMAGE_REQUEST_TIMEOUT);
 
   if (!image) {
     ESP_LOGW(TAG, "SNAPSHOT: failed to acquire frame");
@@ -235,6 +208,9 @@ esp_err_t CameraWebServer::snapshot_handler_(struct httpd_req *req) {
   if (res == ESP_OK) {
     res = httpd_resp_send(req, (const char *) image->get_data_buffer(), image->get_data_length());
   }
+  if (res == ESP_OK) {
+    this->consumer_.frame_sent(*image);
+  }
   return res;
 }
 
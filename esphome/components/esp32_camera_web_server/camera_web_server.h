@@ -3,8 +3,6 @@
 #ifdef USE_ESP32
 
 #include <cinttypes>
-#include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
 
 #include "esphome/components/esp32_camera/esp32_camera.h"
 #include "esphome/core/component.h"
@@ -29,18 +27,15 @@ class CameraWebServer : public Component {
   float get_setup_priority() const override;
   void set_port(uint16_t port) { this->port_ = port; }
   void set_mode(Mode mode) { this->mode_ = mode; }
-  void loop() override;
 
  protected:
-  std::shared_ptr<esphome::esp32_camera::CameraImage> wait_for_image_();
   esp_err_t handler_(struct httpd_req *req);
   esp_err_t streaming_handler_(struct httpd_req *req);
   esp_err_t snapshot_handler_(struct httpd_req *req);
 
   uint16_t port_{0};
   void *httpd_{nullptr};
-  SemaphoreHandle_t semaphore_;
-  std::shared_ptr<esphome::esp32_camera::CameraImage> image_;
+  esp32_camera::CameraImageConsumer consumer_{"web_server", esp32_camera::WEB_REQUESTER};
   bool running_{false};
   Mode mode_{STREAM};
 };
@@ -0,0 +1,44 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_ID,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_TIMER,
+    STATE_CLASS_MEASUREMENT,
+    UNIT_MILLISECOND,
+)
+
+CODEOWNERS = ["@jesserockz"]
+DEPENDENCIES = ["esp32"]
+AUTO_LOAD = ["sensor"]
+MULTI_CONF = True
+
+CONF_ESP32_RMT_LED_STRIP_ID = "esp32_rmt_led_strip_id"
+CONF_FRAME_TIME = "frame_time"
+
+esp32_rmt_led_strip_ns = cg.esphome_ns.namespace("esp32_rmt_led_strip")
+ESP32RMTLEDStripGroup = esp32_rmt_led_strip_ns.class_(
+    "ESP32RMTLEDStripGroup", cg.PollingComponent
+)
+
+CONFIG_SCHEMA = cv.Schema(
+    {
+        cv.GenerateID(): cv.declare_id(ESP32RMTLEDStripGroup),
+        cv.Optional(CONF_FRAME_TIME): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            icon=ICON_TIMER,
+            accuracy_decimals=2,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.polling_component_schema("60s"))
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    if CONF_FRAME_TIME in config:
+        sens = await sensor.new_sensor(config[CONF_FRAME_TIME])
+        cg.add(var.set_frame_time_sensor(sens))
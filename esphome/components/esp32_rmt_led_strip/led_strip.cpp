@@ -7,6 +7,7 @@
 #include "esphome/core/log.h"
 
 #include <esp_attr.h>
+#include <esp_timer.h>
 
 namespace esphome {
 namespace esp32_rmt_led_strip {
@@ -15,6 +16,13 @@ static const char *const TAG = "esp32_rmt_led_strip";
 
 static const uint8_t RMT_CLK_DIV = 2;
 
+// Time at which the last transmission of each channel ended, written from the RMT interrupt
+static volatile uint32_t tx_end_time[RMT_CHANNEL_MAX];
+
+static void IRAM_ATTR rmt_tx_end(rmt_channel_t channel, void *arg) {
+  tx_end_time[channel] = (uint32_t) esp_timer_get_time();
+}
+
 void ESP32RMTLEDStripLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 LED Strip...");
 
@@ -37,6 +45,11 @@ void ESP32RMTLEDStripLightOutput::setup() {
 
   ExternalRAMAllocator<rmt_item32_t> rmt_allocator(ExternalRAMAllocator<rmt_item32_t>::ALLOW_FAILURE);
   this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8);  // 8 bits per byte, 1 rmt_item32_t per bit
+  if (this->rmt_buf_ == nullptr) {
+    ESP_LOGE(TAG, "Cannot allocate RMT buffer!");
+    this->mark_failed();
+    return;
+  }
 
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
@@ -77,6 +90,8 @@ void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bi
   this->bit1_.level0 = 1;
   this->bit1_.duration1 = (uint32_t) (ratio * bit1_low);
   this->bit1_.level1 = 0;
+
+  this->encoder_.set_items(this->bit0_.val, this->bit1_.val);
 }
 
 void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
@@ -92,6 +107,18 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
 
   ESP_LOGVV(TAG, "Writing RGB values to bus...");
 
+  if (this->group_ != nullptr) {
+    // The RMT buffer can't be changed while it is transmitted, try again once the group has finished its frame
+    if (this->is_transmitting_()) {
+      this->schedule_show();
+      return;
+    }
+    this->encode_();
+    this->frame_pending_ = true;
+    this->group_->schedule_frame();
+    return;
+  }
+
   if (rmt_wait_tx_done(this->channel_, pdMS_TO_TICKS(1000)) != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX timeout");
     this->status_set_warning();
@@ -99,29 +126,38 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   }
   delayMicroseconds(50);
 
-  size_t buffer_size = this->get_buffer_size_();
+  this->encode_();
+  this->frame_pending_ = true;
+  this->transmit_();
+}
 
-  size_t size = 0;
-  size_t len = 0;
-  uint8_t *psrc = this->buf_;
-  rmt_item32_t *pdest = this->rmt_buf_;
-  while (size < buffer_size) {
-    uint8_t b = *psrc;
-    for (int i = 0; i < 8; i++) {
-      pdest->val = b & (1 << (7 - i)) ? this->bit1_.val : this->bit0_.val;
-      pdest++;
-      len++;
-    }
-    size++;
-    psrc++;
-  }
+void ESP32RMTLEDStripLightOutput::encode_() {
+  static_assert(sizeof(rmt_item32_t) == sizeof(uint32_t), "RMT items must be 32-bit words");
+  this->encoder_.encode(this->buf_, this->get_buffer_size_(), reinterpret_cast<uint32_t *>(this->rmt_buf_));
+}
 
-  if (rmt_write_items(this->channel_, this->rmt_buf_, len, false) != ESP_OK) {
+bool ESP32RMTLEDStripLightOutput::transmit_() {
+  if (!this->frame_pending_)
+    return false;
+  this->frame_pending_ = false;
+
+  if (rmt_write_items(this->channel_, this->rmt_buf_, this->get_buffer_size_() * 8, false) != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX error");
     this->status_set_warning();
-    return;
+    return false;
   }
   this->status_clear_warning();
+  this->transmitting_ = true;
+  return true;
+}
+
+bool ESP32RMTLEDStripLightOutput::is_transmitting_() {
+  if (!this->transmitting_)
+    return false;
+  if (rmt_wait_tx_done(this->channel_, 0) != ESP_OK)
+    return true;
+  this->transmitting_ = false;
+  return false;
 }
 
 light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
@@ -198,10 +234,72 @@ void ESP32RMTLEDStripLightOutput::dump_config() {
   ESP_LOGCONFIG(TAG, "  RGB Order: %s", rgb_order);
   ESP_LOGCONFIG(TAG, "  Max refresh rate: %" PRIu32, *this->max_refresh_rate_);
   ESP_LOGCONFIG(TAG, "  Number of LEDs: %u", this->num_leds_);
+  ESP_LOGCONFIG(TAG, "  Synchronized: %s", YESNO(this->group_ != nullptr));
 }
 
 float ESP32RMTLEDStripLightOutput::get_setup_priority() const { return setup_priority::HARDWARE; }
 
+void ESP32RMTLEDStripGroup::setup() {
+  // Timestamp the end of each transmission, so the frame time doesn't depend on when loop() gets to check
+  rmt_register_tx_end_callback(rmt_tx_end, nullptr);
+  this->active_strips_.reserve(this->strips_.size());
+}
+
+void ESP32RMTLEDStripGroup::loop() {
+  if (this->transmitting_) {
+    for (auto *strip : this->active_strips_) {
+      if (strip->is_transmitting_())
+        return;
+    }
+    this->transmitting_ = false;
+    uint32_t frame_end = this->frame_start_;
+    for (auto *strip : this->active_strips_) {
+      uint32_t end = tx_end_time[strip->channel_];
+      if (int32_t(end - frame_end) > 0)
+        frame_end = end;
+    }
+    this->frame_time_ = frame_end - this->frame_start_;
+    this->max_frame_time_ = std::max(this->max_frame_time_, this->frame_time_);
+    this->interval_max_frame_time_ = std::max(this->interval_max_frame_time_, this->frame_time_);
+    ESP_LOGVV(TAG, "Frame sent in %" PRIu32 " us (max %" PRIu32 " us)", this->frame_time_, this->max_frame_time_);
+    if (this->frame_pending_) {
+      // give the strips the time to latch the last frame
+      delayMicroseconds(50);
+    }
+  }
+
+  if (!this->frame_pending_)
+    return;
+  this->frame_pending_ = false;
+
+  // Start all strips back to back, they then transmit in parallel on their own RMT channels
+  this->frame_start_ = micros();
+  this->active_strips_.clear();
+  for (auto *strip : this->strips_) {
+    // failed strips may not have an RMT driver installed
+    if (!strip->is_failed() && strip->transmit_())
+      this->active_strips_.push_back(strip);
+  }
+  this->transmitting_ = !this->active_strips_.empty();
+}
+
+void ESP32RMTLEDStripGroup::update() {
+  if (this->interval_max_frame_time_ > 0)
+    ESP_LOGD(TAG, "Max frame time: %" PRIu32 " us (since boot %" PRIu32 " us)", this->interval_max_frame_time_,
+             this->max_frame_time_);
+  if (this->frame_time_sensor_ != nullptr)
+    this->frame_time_sensor_->publish_state(this->interval_max_frame_time_ / 1000.0f);
+  this->interval_max_frame_time_ = 0;
+}
+
+void ESP32RMTLEDStripGroup::dump_config() {
+  ESP_LOGCONFIG(TAG, "ESP32 RMT LED Strip Group:");
+  ESP_LOGCONFIG(TAG, "  Strips: %zu", this->strips_.size());
+  ESP_LOGCONFIG(TAG, "  Max frame time: %" PRIu32 " us", this->max_frame_time_);
+  LOG_UPDATE_INTERVAL(this);
+  LOG_SENSOR("  ", "Frame Time", this->frame_time_sensor_);
+}
+
 }  // namespace esp32_rmt_led_strip
 }  // namespace esphome
 
@@ -4,10 +4,15 @@
 
 #include "esphome/components/light/addressable_light.h"
 #include "esphome/components/light/light_output.h"
+#include "esphome/components/sensor/sensor.h"
 #include "esphome/core/color.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
 
+#include "rmt_encoder.h"
+
+#include <vector>
+
 #include <driver/gpio.h>
 #include <driver/rmt.h>
 #include <esp_err.h>
@@ -24,6 +29,8 @@ enum RGBOrder : uint8_t {
   ORDER_BRG,
 };
 
+class ESP32RMTLEDStripGroup;
+
 class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
  public:
   void setup() override;
@@ -52,6 +59,8 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
 
   void set_rgb_order(RGBOrder rgb_order) { this->rgb_order_ = rgb_order; }
   void set_rmt_channel(rmt_channel_t channel) { this->channel_ = channel; }
+  /// Transmit frames together with the other strips of group, instead of on every write.
+  void set_group(ESP32RMTLEDStripGroup *group) { this->group_ = group; }
 
   void clear_effect_data() override {
     for (int i = 0; i < this->size(); i++)
@@ -63,8 +72,17 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
 
+  friend ESP32RMTLEDStripGroup;
+
   size_t get_buffer_size_() const { return this->num_leds_ * (3 + this->is_rgbw_); }
 
+  /// Encode the LED buffer into the RMT buffer.
+  void encode_();
+  /// Start transmitting the RMT buffer, if a new frame has been encoded into it. Returns true if it was started.
+  bool transmit_();
+  /// Whether a frame started with transmit_() is still being sent.
+  bool is_transmitting_();
+
   uint8_t *buf_{nullptr};
   uint8_t *effect_data_{nullptr};
   rmt_item32_t *rmt_buf_{nullptr};
@@ -74,11 +92,60 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
   bool is_rgbw_;
 
   rmt_item32_t bit0_, bit1_;
+  RMTBitEncoder encoder_;
   RGBOrder rgb_order_;
   rmt_channel_t channel_;
 
   uint32_t last_refresh_{0};
   optional<uint32_t> max_refresh_rate_{};
+
+  ESP32RMTLEDStripGroup *group_{nullptr};
+  bool frame_pending_{false};
+  bool transmitting_{false};
+};
+
+/** Transmits the frames of several LED strips at the same time.
+ *
+ * Each strip in the group only encodes its frame on write. The group then starts all strips back to back on their
+ * own RMT channels and waits for them once, so a frame takes as long as the longest strip instead of the sum of all.
+ */
+class ESP32RMTLEDStripGroup : public PollingComponent {
+ public:
+  void setup() override;
+  void loop() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+  /// Run after the lights, so frames written in this loop iteration are sent right away.
+  float get_loop_priority() const override { return -1.0f; }
+
+  void add_strip(ESP32RMTLEDStripLightOutput *strip) {
+    strip->set_group(this);
+    this->strips_.push_back(strip);
+  }
+
+  /// Send the pending frames of all strips with the next loop.
+  void schedule_frame() { this->frame_pending_ = true; }
+
+  /// Time in µs from starting the last frame until all strips had sent it, taken from the RMT TX end interrupts.
+  uint32_t get_frame_time() const { return this->frame_time_; }
+  uint32_t get_max_frame_time() const { return this->max_frame_time_; }
+
+  /// Report the longest frame time of each update interval in milliseconds.
+  void set_frame_time_sensor(sensor::Sensor *frame_time_sensor) { this->frame_time_sensor_ = frame_time_sensor; }
+
+ protected:
+  std::vector<ESP32RMTLEDStripLightOutput *> strips_;
+  /// strips started with the current frame
+  std::vector<ESP32RMTLEDStripLightOutput *> active_strips_;
+  sensor::Sensor *frame_time_sensor_{nullptr};
+  bool frame_pending_{false};
+  bool transmitting_{false};
+  uint32_t frame_start_{0};
+  uint32_t frame_time_{0};
+  uint32_t max_frame_time_{0};
+  /// longest frame time since the last update
+  uint32_t interval_max_frame_time_{0};
 };
 
 }  // namespace esp32_rmt_led_strip
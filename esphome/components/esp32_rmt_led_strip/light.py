@@ -12,11 +12,15 @@ from esphome.const import (
     CONF_PIN,
     CONF_RGB_ORDER,
 )
+from . import (
+    CONF_ESP32_RMT_LED_STRIP_ID,
+    ESP32RMTLEDStripGroup,
+    esp32_rmt_led_strip_ns,
+)
 
 CODEOWNERS = ["@jesserockz"]
 DEPENDENCIES = ["esp32"]
 
-esp32_rmt_led_strip_ns = cg.esphome_ns.namespace("esp32_rmt_led_strip")
 ESP32RMTLEDStripLightOutput = esp32_rmt_led_strip_ns.class_(
     "ESP32RMTLEDStripLightOutput", light.AddressableLight
 )
@@ -90,6 +94,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_MAX_REFRESH_RATE): cv.positive_time_period_microseconds,
             cv.Optional(CONF_CHIPSET): cv.one_of(*CHIPSETS, upper=True),
             cv.Optional(CONF_IS_RGBW, default=False): cv.boolean,
+            cv.Optional(CONF_ESP32_RMT_LED_STRIP_ID): cv.use_id(
+                ESP32RMTLEDStripGroup
+            ),
             cv.Inclusive(
                 CONF_BIT0_HIGH,
                 "custom",
@@ -151,3 +158,7 @@ async def to_code(config):
             getattr(rmt_channel_t, f"RMT_CHANNEL_{config[CONF_RMT_CHANNEL]}")
         )
     )
+
+    if CONF_ESP32_RMT_LED_STRIP_ID in config:
+        group = await cg.get_variable(config[CONF_ESP32_RMT_LED_STRIP_ID])
+        cg.add(group.add_strip(var))
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace esp32_rmt_led_strip {
+
+/** Expands LED strip data into RMT items, one item per bit, most significant bit first.
+ *
+ * The items for each of the 16 possible nibbles are precomputed, so every byte is encoded with two table lookups and
+ * eight word copies instead of a compare and branch per bit.
+ */
+class RMTBitEncoder {
+ public:
+  /// Set the raw RMT items used for 0 and 1 bits.
+  void set_items(uint32_t bit0, uint32_t bit1) {
+    for (uint8_t nibble = 0; nibble < 16; nibble++) {
+      for (uint8_t bit = 0; bit < 4; bit++)
+        this->nibbles_[nibble][bit] = nibble & (0x08 >> bit) ? bit1 : bit0;
+    }
+  }
+
+  /// Encode len bytes from src into 8 * len items at dst.
+  void encode(const uint8_t *src, size_t len, uint32_t *dst) const {
+    for (const uint8_t *end = src + len; src != end; src++, dst += 8) {
+      const uint32_t *high = this->nibbles_[*src >> 4];
+      const uint32_t *low = this->nibbles_[*src & 0x0F];
+      dst[0] = high[0];
+      dst[1] = high[1];
+      dst[2] = high[2];
+      dst[3] = high[3];
+      dst[4] = low[0];
+      dst[5] = low[1];
+      dst[6] = low[2];
+      dst[7] = low[3];
+    }
+  }
+
+ protected:
+  uint32_t nibbles_[16][4]{};
+};
+
+}  // namespace esp32_rmt_led_strip
+}  // namespace esphome
@@ -1,6 +1,7 @@
 import functools
 from pathlib import Path
 import hashlib
+import logging
 import os
 import re
 from packaging import version
@@ -10,6 +11,7 @@ import requests
 from esphome import core
 import esphome.config_validation as cv
 import esphome.codegen as cg
+from esphome.components.display import rle_encode
 from esphome.helpers import copy_file_if_changed
 from esphome.const import (
     CONF_FAMILY,
@@ -24,6 +26,7 @@ from esphome.const import (
 )
 from esphome.core import CORE, HexInt
 
+_LOGGER = logging.getLogger(__name__)
 
 DOMAIN = "font"
 DEPENDENCIES = ["display"]
@@ -238,6 +241,17 @@ DEFAULT_GLYPHS = (
     ' !"%()+=,-.:/0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_abcdefghijklmnopqrstuvwxyz°'
 )
 CONF_RAW_GLYPH_ID = "raw_glyph_id"
+CONF_RAW_INDEX_ID = "raw_index_id"
+CONF_CACHE_SIZE = "cache_size"
+CONF_ENCODING = "encoding"
+
+ENCODING_NONE = "NONE"
+ENCODING_RLE = "RLE"
+
+# Must match GLYPH_INDEX_NONE, GLYPH_INDEX_SIZE and MAX_RLE_ROW_BYTES in font.h
+GLYPH_INDEX_NONE = 0xFFFF
+GLYPH_INDEX_SIZE = 256
+MAX_RLE_ROW_BYTES = 32
 
 FONT_SCHEMA = cv.Schema(
     {
@@ -247,6 +261,19 @@ FONT_SCHEMA = cv.Schema(
         cv.Optional(CONF_SIZE, default=20): cv.int_range(min=1),
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
+        cv.GenerateID(CONF_RAW_INDEX_ID): cv.declare_id(cg.uint8),
+        cv.Optional(CONF_ENCODING, default=ENCODING_NONE): cv.one_of(
+            ENCODING_NONE, ENCODING_RLE, upper=True
+        ),
+        cv.SplitDefault(
+            CONF_CACHE_SIZE,
+            esp8266=0,
+            esp32=8,
+            rp2040=8,
+            bk72xx=8,
+            rtl87xx=8,
+            host=8,
+        ): cv.int_range(min=0, max=64),
     }
 )
 
@@ -347,6 +374,24 @@ def load_ttf_font(path, size):
     return TrueTypeFontWrapper(font)
 
 
+def glyph_index(glyphs):
+    """Map the ASCII and Latin-1 code points to the index of their glyph.
+
+    Code points without a glyph of their own, or that start a longer glyph, are
+    left at GLYPH_INDEX_NONE and found with a binary search at runtime.
+    """
+    index = [GLYPH_INDEX_NONE] * GLYPH_INDEX_SIZE
+    if len(glyphs) >= GLYPH_INDEX_NONE:
+        return index
+    for glyph_n, glyph in enumerate(glyphs):
+        if len(glyph) == 1 and ord(glyph) < GLYPH_INDEX_SIZE:
+            index[ord(glyph)] = glyph_n
+    for glyph in glyphs:
+        if len(glyph) > 1 and ord(glyph[0]) < GLYPH_INDEX_SIZE:
+            index[ord(glyph[0])] = GLYPH_INDEX_NONE
+    return index
+
+
 async def to_code(config):
     conf = config[CONF_FILE]
     if conf[CONF_TYPE] == TYPE_LOCAL_BITMAP:
@@ -364,6 +409,7 @@ async def to_code(config):
 
     glyph_args = {}
     data = []
+    raw_size = 0
     for glyph in config[CONF_GLYPHS]:
         mask = font.getmask(glyph, mode="1")
         offset_x, offset_y = font.getoffset(glyph)
@@ -376,9 +422,31 @@ async def to_code(config):
                     continue
                 pos = x + y * width8
                 glyph_data[pos // 8] |= 0x80 >> (pos % 8)
-        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height)
+        raw_size += len(glyph_data)
+        rle = False
+        stride = width8 // 8
+        if config[CONF_ENCODING] == ENCODING_RLE and stride <= MAX_RLE_ROW_BYTES:
+            # Rows are encoded on their own, so they can be decoded one at a time.
+            # Small glyphs may not get any smaller, those are stored as they are
+            encoded = []
+            for y in range(height):
+                encoded += rle_encode(glyph_data[y * stride : (y + 1) * stride])
+            if len(encoded) < len(glyph_data):
+                glyph_data = encoded
+                rle = True
+        glyph_args[glyph] = (len(data), offset_x, offset_y, width, height, rle)
         data += glyph_data
 
+    if config[CONF_ENCODING] != ENCODING_NONE:
+        _LOGGER.info(
+            "Font %s: %s encoding uses %d bytes instead of %d (%d bytes saved)",
+            config[CONF_ID],
+            config[CONF_ENCODING],
+            len(data),
+            raw_size,
+            raw_size - len(data),
+        )
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
 
@@ -396,11 +464,27 @@ async def to_code(config):
                 ("offset_y", glyph_args[glyph][2]),
                 ("width", glyph_args[glyph][3]),
                 ("height", glyph_args[glyph][4]),
+                ("rle", glyph_args[glyph][5]),
             )
         )
 
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
-    cg.new_Pvariable(
-        config[CONF_ID], glyphs, len(glyph_initializer), ascent, ascent + descent
+    index = glyph_index(config[CONF_GLYPHS])
+    if any(x != GLYPH_INDEX_NONE for x in index):
+        index_data = []
+        for glyph_n in index:
+            index_data += [HexInt(glyph_n >> 8), HexInt(glyph_n & 0xFF)]
+        index_arr = cg.progmem_array(config[CONF_RAW_INDEX_ID], index_data)
+    else:
+        index_arr = cg.nullptr
+
+    var = cg.new_Pvariable(
+        config[CONF_ID],
+        glyphs,
+        len(glyph_initializer),
+        ascent,
+        ascent + descent,
+        index_arr,
     )
+    cg.add(var.set_cache_size(config[CONF_CACHE_SIZE]))
@@ -1,33 +1,48 @@
 #include "font.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <functional>
+
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/color.h"
 #include "esphome/components/display/display_buffer.h"
+#include "esphome/components/display/rle.h"
 
 namespace esphome {
 namespace font {
 
 static const char *const TAG = "font";
 
+/// Text runs with a larger bitmap are drawn glyph by glyph instead of being cached
+static const size_t MAX_TEXT_RUN_BYTES = 1024;
+
 void Glyph::draw(int x_at, int y_start, display::Display *display, Color color) const {
   int scan_x1, scan_y1, scan_width, scan_height;
   this->scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-  const unsigned char *data = this->glyph_data_->data;
-  const int max_x = x_at + scan_x1 + scan_width;
-  const int max_y = y_start + scan_y1 + scan_height;
-
-  for (int glyph_y = y_start + scan_y1; glyph_y < max_y; glyph_y++) {
-    for (int glyph_x = x_at + scan_x1; glyph_x < max_x; data++, glyph_x += 8) {
-      uint8_t pixel_data = progmem_read_byte(data);
-      const int pixel_max_x = std::min(max_x, glyph_x + 8);
-
-      for (int pixel_x = glyph_x; pixel_x < pixel_max_x && pixel_data; pixel_x++, pixel_data <<= 1) {
-        if (pixel_data & 0x80) {
-          display->draw_pixel_at(pixel_x, glyph_y, color);
-        }
-      }
+  if (!this->glyph_data_->rle) {
+    display->draw_bitmap(x_at + scan_x1, y_start + scan_y1, scan_width, scan_height, this->glyph_data_->data,
+                         display::BITMAP_BINARY, color, display::COLOR_OFF, true);
+    return;
+  }
+  this->for_each_row_([=](int y, const uint8_t *row) {
+    display->draw_bitmap(x_at + scan_x1, y_start + scan_y1 + y, scan_width, 1, row, display::BITMAP_BINARY, color,
+                         display::COLOR_OFF, true);
+  });
+}
+void Glyph::for_each_row_(const std::function<void(int y, const uint8_t *row)> &callback) const {
+  const int stride = (this->glyph_data_->width + 7) / 8;
+  const uint8_t *src = this->glyph_data_->data;
+  uint8_t row[MAX_RLE_ROW_BYTES];
+  for (int y = 0; y < this->glyph_data_->height; y++) {
+    if (this->glyph_data_->rle) {
+      src = display::rle_decode(src, row, stride, 1);
+      callback(y, row);
+    } else {
+      callback(y, src + y * stride);
     }
   }
 }
@@ -65,12 +80,34 @@ void Glyph::scan_area(int *x1, int *y1, int *width, int *height) const {
   *height = this->glyph_data_->height;
 }
 
-Font::Font(const GlyphData *data, int data_nr, int baseline, int height) : baseline_(baseline), height_(height) {
+Font::Font(const GlyphData *data, int data_nr, int baseline, int height, const uint8_t *index)
+    : baseline_(baseline), height_(height), index_(index) {
   glyphs_.reserve(data_nr);
   for (int i = 0; i < data_nr; ++i)
     glyphs_.emplace_back(&data[i]);
 }
 int Font::match_next_glyph(const char *str, int *match_length) {
+  if (this->index_ != nullptr) {
+    // ASCII and Latin-1 code points (U+0080 to U+00FF are encoded with a 0xC2 or 0xC3 lead byte) are looked up directly
+    const uint8_t lead = str[0];
+    int code_point = -1;
+    int length = 1;
+    if (lead < 0x80) {
+      code_point = lead;
+    } else if ((lead == 0xC2 || lead == 0xC3) && (str[1] & 0xC0) == 0x80) {
+      code_point = ((lead & 0x1F) << 6) | (str[1] & 0x3F);
+      length = 2;
+    }
+    if (code_point >= 0) {
+      const uint8_t *entry = this->index_ + code_point * 2;
+      const uint16_t glyph_n = (progmem_read_byte(entry) << 8) | progmem_read_byte(entry + 1);
+      if (glyph_n != GLYPH_INDEX_NONE) {
+        *match_length = length;
+        return glyph_n;
+      }
+    }
+  }
+
   int lo = 0;
   int hi = this->glyphs_.size() - 1;
   while (lo != hi) {
@@ -89,6 +126,14 @@ int Font::match_next_glyph(const char *str, int *match_length) {
 void Font::measure(const char *str, int *width, int *x_offset, int *baseline, int *height) {
   *baseline = this->baseline_;
   *height = this->height_;
+  if (this->cache_size_ > 0) {
+    const TextRun *run = this->find_text_run_(str, fnv1_hash(str, strlen(str)));
+    if (run != nullptr) {
+      *width = run->width;
+      *x_offset = run->x_offset;
+      return;
+    }
+  }
   int i = 0;
   int min_x = 0;
   bool has_char = false;
@@ -119,6 +164,15 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   *width = x - min_x;
 }
 void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text) {
+  if (this->cache_size_ > 0) {
+    const TextRun *run = this->get_text_run_(text);
+    if (run != nullptr) {
+      display->draw_bitmap(x_start + run->bitmap_x, y_start + run->bitmap_y, run->bitmap_width, run->bitmap_height,
+                           run->bitmap.data(), display::BITMAP_BINARY, color, display::COLOR_OFF, true);
+      return;
+    }
+  }
+
   int i = 0;
   int x_at = x_start;
   while (text[i] != '\0') {
@@ -145,5 +199,131 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
   }
 }
 
+TextRun *Font::find_text_run_(const char *text, uint32_t hash) {
+  for (auto &run : this->text_runs_) {
+    if (run.hash == hash && run.text == text) {
+      run.last_used = ++this->cache_clock_;
+      return &run;
+    }
+  }
+  return nullptr;
+}
+const TextRun *Font::get_text_run_(const char *text) {
+  const uint32_t hash = fnv1_hash(text, strlen(text));
+  TextRun *run = this->find_text_run_(text, hash);
+  if (run != nullptr)
+    return run;
+  if (!this->admit_text_run_(hash))
+    return nullptr;
+
+  TextRun rendered;
+  if (!this->render_text_run_(text, rendered))
+    return nullptr;
+  rendered.hash = hash;
+  rendered.last_used = ++this->cache_clock_;
+
+  if (this->text_runs_.size() < this->cache_size_) {
+    this->text_runs_.push_back(std::move(rendered));
+    return &this->text_runs_.back();
+  }
+  run = &*std::min_element(this->text_runs_.begin(), this->text_runs_.end(),
+                           [](const TextRun &a, const TextRun &b) { return a.last_used < b.last_used; });
+  *run = std::move(rendered);
+  return run;
+}
+bool Font::admit_text_run_(uint32_t hash) {
+  auto it = std::find(this->missed_hashes_.begin(), this->missed_hashes_.end(), hash);
+  if (it != this->missed_hashes_.end()) {
+    *it = 0;
+    return true;
+  }
+  if (this->missed_hashes_.size() < this->cache_size_) {
+    this->missed_hashes_.push_back(hash);
+  } else {
+    this->missed_hashes_[this->missed_next_] = hash;
+    this->missed_next_ = (this->missed_next_ + 1) % this->cache_size_;
+  }
+  return false;
+}
+bool Font::render_text_run_(const char *text, TextRun &run) {
+  // Visit the glyphs at the same positions print() draws them, unknown characters are drawn as a filled box
+  auto for_each_glyph = [this, text](const std::function<void(int x, const Glyph *glyph, char c)> &callback) {
+    int i = 0;
+    int x_at = 0;
+    while (text[i] != '\0') {
+      int match_length;
+      int glyph_n = this->match_next_glyph(text + i, &match_length);
+      if (glyph_n < 0) {
+        if (!this->glyphs_.empty()) {
+          callback(x_at, nullptr, text[i]);
+          x_at += this->glyphs_[0].glyph_data_->width;
+        }
+        i++;
+        continue;
+      }
+      const Glyph &glyph = this->glyphs_[glyph_n];
+      callback(x_at, &glyph, text[i]);
+      x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
+      i += match_length;
+    }
+  };
+
+  int x1 = INT_MAX, y1 = INT_MAX, x2 = INT_MIN, y2 = INT_MIN;
+  for_each_glyph([this, &x1, &y1, &x2, &y2](int x, const Glyph *glyph, char) {
+    if (glyph == nullptr) {
+      x1 = std::min(x1, x);
+      y1 = std::min(y1, 0);
+      x2 = std::max(x2, x + this->glyphs_[0].glyph_data_->width);
+      y2 = std::max(y2, this->height_);
+      return;
+    }
+    const GlyphData *data = glyph->glyph_data_;
+    x1 = std::min(x1, x + data->offset_x);
+    y1 = std::min(y1, data->offset_y);
+    x2 = std::max(x2, x + data->offset_x + data->width);
+    y2 = std::max(y2, data->offset_y + data->height);
+  });
+  if (x1 >= x2 || y1 >= y2)
+    x1 = y1 = x2 = y2 = 0;
+
+  const int stride = (x2 - x1 + 7) / 8;
+  if (size_t(stride) * (y2 - y1) > MAX_TEXT_RUN_BYTES)
+    return false;
+  run.text = text;
+  run.bitmap_x = x1;
+  run.bitmap_y = y1;
+  run.bitmap_width = x2 - x1;
+  run.bitmap_height = y2 - y1;
+  run.bitmap.assign(stride * (y2 - y1), 0);
+
+  uint8_t *bitmap = run.bitmap.data();
+  auto set_pixel = [bitmap, stride, x1, y1](int x, int y) {
+    x -= x1;
+    y -= y1;
+    bitmap[y * stride + x / 8] |= 0x80 >> (x % 8);
+  };
+  for_each_glyph([this, &set_pixel](int x, const Glyph *glyph, char c) {
+    if (glyph == nullptr) {
+      ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", c);
+      for (int y = 0; y < this->height_; y++) {
+        for (int i = 0; i < this->glyphs_[0].glyph_data_->width; i++)
+          set_pixel(x + i, y);
+      }
+      return;
+    }
+    const GlyphData *data = glyph->glyph_data_;
+    glyph->for_each_row_([&set_pixel, x, data](int y, const uint8_t *row) {
+      for (int i = 0; i < data->width; i++) {
+        if (progmem_read_byte(row + i / 8) & (0x80 >> (i % 8)))
+          set_pixel(x + data->offset_x + i, data->offset_y + y);
+      }
+    });
+  });
+
+  int baseline, height;
+  this->measure(text, &run.width, &run.x_offset, &baseline, &height);
+  return true;
+}
+
 }  // namespace font
 }  // namespace esphome
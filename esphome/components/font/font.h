@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <string>
+#include <vector>
+
 #include "esphome/core/datatypes.h"
 #include "esphome/core/color.h"
 #include "esphome/components/display/display_buffer.h"
@@ -16,6 +20,8 @@ struct GlyphData {
   int offset_y;
   int width;
   int height;
+  /// Whether each row of data is run-length encoded by the byte on its own, see display::rle_decode()
+  bool rle;
 };
 
 class Glyph {
@@ -35,9 +41,36 @@ class Glyph {
  protected:
   friend Font;
 
+  /// Call callback with each row of the bitmap, rows of encoded glyphs are decoded one at a time on the stack.
+  void for_each_row_(const std::function<void(int y, const uint8_t *row)> &callback) const;
+
   const GlyphData *glyph_data_;
 };
 
+/// A run of text rasterized into a 1-bit bitmap, so it can be drawn again with a single blit.
+struct TextRun {
+  std::string text;
+  uint32_t hash;
+  uint32_t last_used;
+  /// The results of Font::measure() for the text
+  int width;
+  int x_offset;
+  /// Position of the bitmap relative to the start of the text
+  int bitmap_x;
+  int bitmap_y;
+  int bitmap_width;
+  int bitmap_height;
+  std::vector<uint8_t> bitmap;
+};
+
+/// Only glyphs with rows of up to this many bytes are run-length encoded, so a decoded row fits on the stack.
+static const int MAX_RLE_ROW_BYTES = 32;
+
+/// Marks code points without an entry in the glyph index, these are looked up with a binary search.
+static const uint16_t GLYPH_INDEX_NONE = 0xFFFF;
+/// The glyph index covers the ASCII and Latin-1 code points.
+static const int GLYPH_INDEX_SIZE = 256;
+
 class Font : public display::BaseFont {
  public:
   /** Construct the font with the given glyphs.
@@ -45,11 +78,15 @@ class Font : public display::BaseFont {
    * @param glyphs A vector of glyphs, must be sorted lexicographically.
    * @param baseline The y-offset from the top of the text to the baseline.
    * @param bottom The y-offset from the top of the text to the bottom (i.e. height).
+   * @param index Optional table of GLYPH_INDEX_SIZE big endian 16-bit glyph indices by code point.
    */
-  Font(const GlyphData *data, int data_nr, int baseline, int height);
+  Font(const GlyphData *data, int data_nr, int baseline, int height, const uint8_t *index = nullptr);
 
   int match_next_glyph(const char *str, int *match_length);
 
+  /// Set the number of rendered text runs to keep, 0 disables the text cache.
+  void set_cache_size(uint8_t cache_size) { this->cache_size_ = cache_size; }
+
   void print(int x_start, int y_start, display::Display *display, Color color, const char *text) override;
   void measure(const char *str, int *width, int *x_offset, int *baseline, int *height) override;
   inline int get_baseline() { return this->baseline_; }
@@ -58,9 +95,30 @@ class Font : public display::BaseFont {
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
  protected:
+  /// Find the cached run for text, or nullptr if it isn't cached.
+  TextRun *find_text_run_(const char *text, uint32_t hash);
+  /** Find the cached run for text, rendering it into the least recently used slot when it isn't cached yet.
+   *
+   * Text is only rendered into the cache when it was already printed within the last cache_size_ misses, text that
+   * changes on every update would otherwise be rendered twice and evict the runs that are reused.
+   */
+  const TextRun *get_text_run_(const char *text);
+  /// Remember the hash of text that missed the cache, returns true if it missed recently and should be cached.
+  bool admit_text_run_(uint32_t hash);
+  /// Render text into run, returns false if the bitmap would be too large to cache.
+  bool render_text_run_(const char *text, TextRun &run);
+
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
   int baseline_;
   int height_;
+  const uint8_t *index_;
+
+  uint8_t cache_size_{0};
+  uint32_t cache_clock_{0};
+  std::vector<TextRun> text_runs_;
+  /// hashes of the texts of the last cache misses, a ring of cache_size_ entries
+  std::vector<uint32_t> missed_hashes_;
+  uint8_t missed_next_{0};
 };
 
 }  // namespace font
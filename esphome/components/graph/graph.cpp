@@ -17,7 +17,7 @@ static const char *const TAGL = "graphlegend";
 
 void HistoryData::init(int length) {
   this->length_ = length;
-  this->samples_.resize(length, NAN);
+  this->buckets_.resize(length, Bucket{NAN, NAN, NAN});
   this->last_sample_ = millis();
 }
 
@@ -26,27 +26,55 @@ void HistoryData::take_sample(float data) {
   uint32_t dt = tm - last_sample_;
   last_sample_ = tm;
 
+  if (!std::isnan(data)) {
+    if (this->pending_count_ == 0) {
+      this->pending_min_ = data;
+      this->pending_max_ = data;
+    } else {
+      this->pending_min_ = std::min(this->pending_min_, data);
+      this->pending_max_ = std::max(this->pending_max_, data);
+    }
+    this->pending_sum_ += data;
+    this->pending_count_++;
+  }
+
   // Step data based on time
   this->period_ += dt;
+  bool stepped = false;
   while (this->period_ >= this->update_time_) {
-    this->samples_[this->count_] = data;
+    Bucket &bucket = this->buckets_[this->count_];
+    if (this->pending_count_ > 0) {
+      bucket = Bucket{this->pending_min_, this->pending_max_, this->pending_sum_ / this->pending_count_};
+    } else {
+      // buckets without samples of their own hold the latest value
+      bucket = Bucket{data, data, data};
+    }
+    this->pending_sum_ = 0.0f;
+    this->pending_count_ = 0;
     this->period_ -= this->update_time_;
     this->count_ = (this->count_ + 1) % this->length_;
-    ESP_LOGV(TAG, "Updating trace with value: %f", data);
+    stepped = true;
+    ESP_LOGV(TAG, "Updating trace with min %f, max %f, mean %f", bucket.min, bucket.max, bucket.mean);
   }
-  if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+
+  if (stepped) {
+    // A bucket has dropped out of the history, recalc recent max/min
+    this->recent_min_ = NAN;
+    this->recent_max_ = NAN;
+    for (const Bucket &bucket : this->buckets_)
+      this->update_recent_(bucket.min, bucket.max);
   }
+  if (this->pending_count_ > 0)
+    this->update_recent_(this->pending_min_, this->pending_max_);
+}
+
+void HistoryData::update_recent_(float min, float max) {
+  if (std::isnan(min))
+    return;
+  if (std::isnan(this->recent_min_) || this->recent_min_ > min)
+    this->recent_min_ = min;
+  if (std::isnan(this->recent_max_) || this->recent_max_ < max)
+    this->recent_max_ = max;
 }
 
 void GraphTrace::init(Graph *g) {
@@ -165,16 +193,20 @@ void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color colo
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
+    if (thick == 0)
+      continue;
+    const HistoryData *data = trace->get_tracedata();
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
+      float vmin = (data->get_min(i) - ymin) / yrange;
+      float vmax = (data->get_max(i) - ymin) / yrange;
+      if (!std::isnan(vmin)) {
         int16_t x = this->width_ - 1 - i;
         uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
         if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
-          for (uint16_t t = 0; t < thick; t++) {
-            buff->draw_pixel_at(x_offset + x, y_offset + y + t, c);
-          }
+          // Span all values of the bucket in one line, thick is added to both ends
+          int16_t y_top = (int16_t) roundf((this->height_ - 1) * (1.0 - vmax)) - thick / 2;
+          int16_t y_bottom = (int16_t) roundf((this->height_ - 1) * (1.0 - vmin)) - thick / 2;
+          buff->vertical_line(x_offset + x, y_offset + y_top, y_bottom - y_top + thick, c);
         }
       }
     }
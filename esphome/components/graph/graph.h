@@ -83,18 +83,35 @@ class GraphLegend {
   friend Graph;
 };
 
+/** The history of a trace, with one bucket per pixel column of the graph.
+ *
+ * The buckets form a ring buffer, each holding the minimum, maximum and mean of the samples taken during its time
+ * span. Samples are folded into the bucket in progress as they arrive, so any duration is downsampled to the width of
+ * the graph without keeping the samples themselves.
+ */
 class HistoryData {
  public:
   void init(int length);
-  ~HistoryData();
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
+  /// Mean of the samples in bucket idx, counting back from the most recent bucket.
+  float get_value(int idx) const { return this->buckets_[this->bucket_index_(idx)].mean; }
+  float get_min(int idx) const { return this->buckets_[this->bucket_index_(idx)].min; }
+  float get_max(int idx) const { return this->buckets_[this->bucket_index_(idx)].max; }
   float get_recent_max() const { return recent_max_; }
   float get_recent_min() const { return recent_min_; }
 
  protected:
+  struct Bucket {
+    float min;
+    float max;
+    float mean;
+  };
+
+  int bucket_index_(int idx) const { return (count_ + length_ - 1 - idx) % length_; }
+  void update_recent_(float min, float max);
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
@@ -102,7 +119,12 @@ class HistoryData {
   int count_{0};
   float recent_min_{NAN};
   float recent_max_{NAN};
-  std::vector<float> samples_;
+  std::vector<Bucket> buckets_;
+  // Samples of the bucket in progress
+  float pending_min_{NAN};
+  float pending_max_{NAN};
+  float pending_sum_{0.0f};
+  uint32_t pending_count_{0};
 };
 
 class GraphTrace {
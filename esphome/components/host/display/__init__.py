@@ -0,0 +1,55 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import display
+from esphome.const import (
+    CONF_DIMENSIONS,
+    CONF_ID,
+    CONF_LAMBDA,
+    CONF_OUTPUT,
+    CONF_PAGES,
+    PLATFORM_HOST,
+)
+
+CODEOWNERS = ["@esphome/core"]
+
+host_ns = cg.esphome_ns.namespace("host")
+HostDisplay = host_ns.class_("HostDisplay", cg.PollingComponent, display.DisplayBuffer)
+
+
+def validate_output(value):
+    value = cv.string_strict(value)
+    if not value.endswith((".png", ".ppm")):
+        raise cv.Invalid("Output file must end with .png or .ppm")
+    if value.count("%") > 1 or ("%" in value and "%u" not in value):
+        raise cv.Invalid(
+            "Output file may only contain a single %u for the frame number"
+        )
+    return value
+
+
+CONFIG_SCHEMA = cv.All(
+    display.FULL_DISPLAY_SCHEMA.extend(
+        {
+            cv.GenerateID(): cv.declare_id(HostDisplay),
+            cv.Required(CONF_DIMENSIONS): cv.dimensions,
+            cv.Optional(CONF_OUTPUT): validate_output,
+        }
+    ).extend(cv.polling_component_schema("1s")),
+    cv.has_at_most_one_key(CONF_PAGES, CONF_LAMBDA),
+    cv.only_on([PLATFORM_HOST]),
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+    await display.register_display(var, config)
+
+    cg.add(var.set_dimensions(*config[CONF_DIMENSIONS]))
+    if CONF_OUTPUT in config:
+        cg.add(var.set_output(config[CONF_OUTPUT]))
+    if CONF_LAMBDA in config:
+        lambda_ = await cg.process_lambda(
+            config[CONF_LAMBDA], [(display.DisplayRef, "it")], return_type=cg.void
+        )
+        cg.add(var.set_writer(lambda_))
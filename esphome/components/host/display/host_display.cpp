@@ -0,0 +1,189 @@
+#ifdef USE_HOST
+
+#include "host_display.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace host {
+
+static const char *const TAG = "host.display";
+
+/// Largest block size of an uncompressed deflate block
+static const size_t PNG_MAX_STORED_BLOCK = 65535;
+
+void HostDisplay::setup() { this->frame_.assign(this->width_ * this->height_ * 3, 0); }
+
+void HostDisplay::update() {
+  this->pixels_touched_ = 0;
+  const uint32_t start = micros();
+  this->do_update_();
+  this->render_time_ = micros() - start;
+
+  this->frame_count_++;
+  this->max_render_time_ = std::max(this->max_render_time_, this->render_time_);
+  this->total_render_time_ += this->render_time_;
+  ESP_LOGD(TAG, "Frame %" PRIu32 " rendered in %" PRIu32 " us (avg %" PRIu32 " us, max %" PRIu32 " us), %" PRIu32
+           " pixels touched",
+           this->frame_count_, this->render_time_, uint32_t(this->total_render_time_ / this->frame_count_),
+           this->max_render_time_, this->pixels_touched_);
+
+  if (!this->output_.empty()) {
+    char path[256];
+    snprintf(path, sizeof(path), this->output_.c_str(), this->frame_count_);
+    this->save(path);
+  }
+}
+
+void HostDisplay::dump_config() {
+  LOG_DISPLAY("", "Host Display", this);
+  ESP_LOGCONFIG(TAG, "  Dimensions: %dx%d", this->width_, this->height_);
+  if (!this->output_.empty())
+    ESP_LOGCONFIG(TAG, "  Output: %s", this->output_.c_str());
+  LOG_UPDATE_INTERVAL(this);
+}
+
+Color HostDisplay::get_pixel_internal(int x, int y) const {
+  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
+    return display::COLOR_OFF;
+  const uint8_t *pixel = &this->frame_[(y * this->width_ + x) * 3];
+  return Color(pixel[0], pixel[1], pixel[2]);
+}
+
+void HOT HostDisplay::draw_absolute_pixel_internal(int x, int y, Color color) {
+  if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
+    return;
+  uint8_t *pixel = &this->frame_[(y * this->width_ + x) * 3];
+  pixel[0] = color.r;
+  pixel[1] = color.g;
+  pixel[2] = color.b;
+  this->pixels_touched_++;
+}
+
+void HOT HostDisplay::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const int x2 = std::min(x + width, this->width_);
+  const int y2 = std::min(y + height, this->height_);
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  for (int row = y; row < y2; row++) {
+    uint8_t *pixel = &this->frame_[(row * this->width_ + x) * 3];
+    for (int col = x; col < x2; col++) {
+      *pixel++ = color.r;
+      *pixel++ = color.g;
+      *pixel++ = color.b;
+    }
+  }
+  if (x2 > x && y2 > y)
+    this->pixels_touched_ += (x2 - x) * (y2 - y);
+}
+
+void HOT HostDisplay::draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) {
+  for (int i = 0; i < len; i++, x += dx, y += dy)
+    this->draw_absolute_pixel_internal(x, y, colors[i]);
+}
+
+bool HostDisplay::save(const std::string &path) const {
+  if (str_endswith(path, ".png"))
+    return this->save_png(path);
+  return this->save_ppm(path);
+}
+
+bool HostDisplay::save_ppm(const std::string &path) const {
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    ESP_LOGW(TAG, "Could not open %s for writing", path.c_str());
+    return false;
+  }
+  fprintf(file, "P6\n%d %d\n255\n", this->width_, this->height_);
+  bool ok = fwrite(this->frame_.data(), 1, this->frame_.size(), file) == this->frame_.size();
+  ok = fclose(file) == 0 && ok;
+  if (!ok)
+    ESP_LOGW(TAG, "Could not write %s", path.c_str());
+  return ok;
+}
+
+static uint32_t png_crc32(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static void png_put_u32(std::vector<uint8_t> &out, uint32_t value) {
+  out.push_back(value >> 24);
+  out.push_back(value >> 16);
+  out.push_back(value >> 8);
+  out.push_back(value);
+}
+
+static void png_put_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+  png_put_u32(out, data.size());
+  const size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  png_put_u32(out, png_crc32(0, &out[start], out.size() - start));
+}
+
+bool HostDisplay::save_png(const std::string &path) const {
+  // The image data is stored in uncompressed deflate blocks, that keeps the writer small and the files exact.
+  const size_t row_size = this->width_ * 3 + 1;
+  std::vector<uint8_t> raw;
+  raw.reserve(row_size * this->height_);
+  for (int y = 0; y < this->height_; y++) {
+    raw.push_back(0);  // filter type none
+    auto row = this->frame_.begin() + y * this->width_ * 3;
+    raw.insert(raw.end(), row, row + this->width_ * 3);
+  }
+
+  std::vector<uint8_t> idat{0x78, 0x01};
+  uint32_t adler_a = 1, adler_b = 0;
+  for (uint8_t value : raw) {
+    adler_a = (adler_a + value) % 65521;
+    adler_b = (adler_b + adler_a) % 65521;
+  }
+  for (size_t offset = 0; offset < raw.size() || offset == 0; offset += PNG_MAX_STORED_BLOCK) {
+    const size_t len = std::min(raw.size() - offset, PNG_MAX_STORED_BLOCK);
+    idat.push_back(offset + len >= raw.size());
+    idat.push_back(len);
+    idat.push_back(len >> 8);
+    idat.push_back(~len);
+    idat.push_back(~len >> 8);
+    idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + len);
+  }
+  png_put_u32(idat, (adler_b << 16) | adler_a);
+
+  std::vector<uint8_t> ihdr;
+  png_put_u32(ihdr, this->width_);
+  png_put_u32(ihdr, this->height_);
+  ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0});  // 8-bit RGB, no interlacing
+
+  std::vector<uint8_t> png{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  png_put_chunk(png, "IHDR", ihdr);
+  png_put_chunk(png, "IDAT", idat);
+  png_put_chunk(png, "IEND", {});
+
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    ESP_LOGW(TAG, "Could not open %s for writing", path.c_str());
+    return false;
+  }
+  bool ok = fwrite(png.data(), 1, png.size(), file) == png.size();
+  ok = fclose(file) == 0 && ok;
+  if (!ok)
+    ESP_LOGW(TAG, "Could not write %s", path.c_str());
+  return ok;
+}
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -0,0 +1,74 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include <string>
+#include <vector>
+
+#include "esphome/components/display/display_buffer.h"
+#include "esphome/core/component.h"
+
+namespace esphome {
+namespace host {
+
+/** Display rendering into an RGB buffer in memory.
+ *
+ * Meant for rendering benchmarks and golden image tests on the host: every frame can be written to a PNG or PPM file,
+ * and the render time and the number of pixels touched are reported for each frame.
+ */
+class HostDisplay : public PollingComponent, public display::DisplayBuffer {
+ public:
+  void setup() override;
+  void update() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::PROCESSOR; }
+
+  display::DisplayType get_display_type() override { return display::DisplayType::DISPLAY_TYPE_COLOR; }
+
+  void set_dimensions(int width, int height) {
+    this->width_ = width;
+    this->height_ = height;
+  }
+  /// Write each frame to this file, the format is picked by the extension. A %u is replaced by the frame number.
+  void set_output(const std::string &output) { this->output_ = output; }
+
+  /// Color of the pixel at the given position, without rotation applied.
+  Color get_pixel_internal(int x, int y) const;
+  /// The frame as rows of 8-bit RGB pixels, without rotation applied.
+  const std::vector<uint8_t> &get_frame() const { return this->frame_; }
+
+  /// Write the current frame to a file, as PNG if the name ends with .png and as binary PPM otherwise.
+  bool save(const std::string &path) const;
+  bool save_ppm(const std::string &path) const;
+  bool save_png(const std::string &path) const;
+
+  uint32_t get_frame_count() const { return this->frame_count_; }
+  /// Time taken to render the last frame in microseconds.
+  uint32_t get_render_time() const { return this->render_time_; }
+  /// Number of pixel writes during the last frame, pixels written more than once are counted each time.
+  uint32_t get_pixels_touched() const { return this->pixels_touched_; }
+
+ protected:
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+
+  void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) override;
+
+  int width_{0};
+  int height_{0};
+  std::vector<uint8_t> frame_;
+  std::string output_;
+
+  uint32_t frame_count_{0};
+  uint32_t render_time_{0};
+  uint32_t max_render_time_{0};
+  uint64_t total_render_time_{0};
+  uint32_t pixels_touched_{0};
+};
+
+}  // namespace host
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -1,6 +1,7 @@
 #include "htu21d.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 namespace htu21d {
@@ -39,32 +40,28 @@ void HTU21DComponent::dump_config() {
   LOG_SENSOR("  ", "Humidity", this->humidity_);
 }
 void HTU21DComponent::update() {
-  uint16_t raw_temperature;
-  if (this->write(&HTU21D_REGISTER_TEMPERATURE, 1) != i2c::ERROR_OK) {
-    this->status_set_warning();
-    return;
-  }
-  delay(50);  // NOLINT
-  if (this->read(reinterpret_cast<uint8_t *>(&raw_temperature), 2) != i2c::ERROR_OK) {
-    this->status_set_warning();
+  if (this->measuring_) {
+    ESP_LOGW(TAG, "Previous measurement still in progress, skipping update");
     return;
   }
-  raw_temperature = i2c::i2ctohs(raw_temperature);
+  this->measuring_ = true;
+  // The conversion delays let the bus serve other devices instead of blocking the main loop
+  auto transaction = this->transaction();
+  transaction.write(&HTU21D_REGISTER_TEMPERATURE, 1).delay(50).read(2);
+  transaction.write(&HTU21D_REGISTER_HUMIDITY, 1).delay(50).read(2);
+  transaction.on_complete([this](i2c::ErrorCode err, const std::vector<uint8_t> &data) {
+    this->measuring_ = false;
+    if (err != i2c::ERROR_OK) {
+      this->status_set_warning();
+      return;
+    }
+    this->publish_measurement_(encode_uint16(data[0], data[1]), encode_uint16(data[2], data[3]));
+  });
+  this->submit(std::move(transaction));
+}
 
+void HTU21DComponent::publish_measurement_(uint16_t raw_temperature, uint16_t raw_humidity) {
   float temperature = (float(raw_temperature & 0xFFFC)) * 175.72f / 65536.0f - 46.85f;
-
-  uint16_t raw_humidity;
-  if (this->write(&HTU21D_REGISTER_HUMIDITY, 1) != i2c::ERROR_OK) {
-    this->status_set_warning();
-    return;
-  }
-  delay(50);  // NOLINT
-  if (this->read(reinterpret_cast<uint8_t *>(&raw_humidity), 2) != i2c::ERROR_OK) {
-    this->status_set_warning();
-    return;
-  }
-  raw_humidity = i2c::i2ctohs(raw_humidity);
-
   float humidity = (float(raw_humidity & 0xFFFC)) * 125.0f / 65536.0f - 6.0f;
 
   int8_t heater_level = this->get_heater_level();
@@ -31,6 +31,9 @@ class HTU21DComponent : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor *temperature_{nullptr};
   sensor::Sensor *humidity_{nullptr};
   sensor::Sensor *heater_{nullptr};
+  bool measuring_{false};
+
+  void publish_measurement_(uint16_t raw_temperature, uint16_t raw_humidity);
 };
 
 template<typename... Ts> class SetHeaterLevelAction : public Action<Ts...>, public Parented<HTU21DComponent> {
@@ -8,7 +8,9 @@ namespace i2c {
 static const char *const TAG = "i2c";
 
 ErrorCode I2CDevice::read_register(uint8_t a_register, uint8_t *data, size_t len, bool stop) {
-  ErrorCode err = this->write(&a_register, 1, stop);
+  // keep other transfers from ending up between the register write and the read
+  LockGuard guard(bus_->get_lock());
+  ErrorCode err = bus_->write(address_, &a_register, 1, stop);
   if (err != ERROR_OK)
     return err;
   return bus_->read(address_, data, len);
@@ -16,7 +18,8 @@ ErrorCode I2CDevice::read_register(uint8_t a_register, uint8_t *data, size_t len
 
 ErrorCode I2CDevice::read_register16(uint16_t a_register, uint8_t *data, size_t len, bool stop) {
   a_register = convert_big_endian(a_register);
-  ErrorCode const err = this->write(reinterpret_cast<const uint8_t *>(&a_register), 2, stop);
+  LockGuard guard(bus_->get_lock());
+  ErrorCode const err = bus_->write(address_, reinterpret_cast<const uint8_t *>(&a_register), 2, stop);
   if (err != ERROR_OK)
     return err;
   return bus_->read(address_, data, len);
@@ -28,6 +31,7 @@ ErrorCode I2CDevice::write_register(uint8_t a_register, const uint8_t *data, siz
   buffers[0].len = 1;
   buffers[1].data = data;
   buffers[1].len = len;
+  LockGuard guard(bus_->get_lock());
   return bus_->writev(address_, buffers, 2, stop);
 }
 
@@ -38,6 +42,7 @@ ErrorCode I2CDevice::write_register16(uint16_t a_register, const uint8_t *data,
   buffers[0].len = 2;
   buffers[1].data = data;
   buffers[1].len = len;
+  LockGuard guard(bus_->get_lock());
   return bus_->writev(address_, buffers, 2, stop);
 }
 
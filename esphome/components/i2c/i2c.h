@@ -65,14 +65,24 @@ class I2CDevice {
   I2CRegister reg(uint8_t a_register) { return {this, a_register}; }
   I2CRegister16 reg16(uint16_t a_register) { return {this, a_register}; }
 
-  ErrorCode read(uint8_t *data, size_t len) { return bus_->read(address_, data, len); }
+  ErrorCode read(uint8_t *data, size_t len) {
+    LockGuard guard(bus_->get_lock());
+    return bus_->read(address_, data, len);
+  }
   ErrorCode read_register(uint8_t a_register, uint8_t *data, size_t len, bool stop = true);
   ErrorCode read_register16(uint16_t a_register, uint8_t *data, size_t len, bool stop = true);
 
-  ErrorCode write(const uint8_t *data, uint8_t len, bool stop = true) { return bus_->write(address_, data, len, stop); }
+  ErrorCode write(const uint8_t *data, uint8_t len, bool stop = true) {
+    LockGuard guard(bus_->get_lock());
+    return bus_->write(address_, data, len, stop);
+  }
   ErrorCode write_register(uint8_t a_register, const uint8_t *data, size_t len, bool stop = true);
   ErrorCode write_register16(uint16_t a_register, const uint8_t *data, size_t len, bool stop = true);
 
+  /// Start an asynchronous transaction for this device, queue it with submit()
+  I2CTransaction transaction() { return I2CTransaction(this->address_); }
+  void submit(I2CTransaction &&transaction) { this->bus_->submit(std::move(transaction)); }
+
   // Compat APIs
 
   bool read_bytes(uint8_t a_register, uint8_t *data, uint8_t len) {
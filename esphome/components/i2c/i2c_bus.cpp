@@ -0,0 +1,113 @@
+#include "i2c_bus.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c";
+
+void I2CBus::submit(I2CTransaction &&transaction) {
+  auto queued = make_unique<I2CTransaction>(std::move(transaction));
+  queued->submitted_at_ = millis();
+  queued->resume_at_ = queued->submitted_at_;
+  {
+    LockGuard guard(this->transaction_lock_);
+    this->submitted_transactions_.push_back(std::move(queued));
+  }
+  this->on_transaction_submitted_();
+}
+
+uint32_t I2CBus::run_transactions_() {
+  {
+    LockGuard guard(this->transaction_lock_);
+    for (auto &transaction : this->submitted_transactions_)
+      this->active_transactions_.push_back(std::move(transaction));
+    this->submitted_transactions_.clear();
+  }
+  if (this->active_transactions_.empty())
+    return UINT32_MAX;
+
+  uint32_t next_due = UINT32_MAX;
+  for (auto &transaction : this->active_transactions_) {
+    // the due steps run back to back, so no transfer of the main loop ends up between a write and its read
+    LockGuard guard(this->bus_lock_);
+    while (!transaction->is_done_()) {
+      uint32_t now = millis();
+      int32_t wait = int32_t(transaction->resume_at_ - now);
+      if (wait > 0) {
+        next_due = std::min(next_due, uint32_t(wait));
+        break;
+      }
+
+      auto &step = transaction->steps_[transaction->next_step_++];
+      if (step.type == I2CTransaction::STEP_DELAY) {
+        transaction->resume_at_ = now + step.value;
+        continue;
+      }
+
+      uint32_t start = micros();
+      ErrorCode err;
+      if (step.type == I2CTransaction::STEP_WRITE) {
+        err = this->write(transaction->address_, step.data.data(), step.data.size(), step.stop);
+      } else {
+        size_t offset = transaction->read_data_.size();
+        transaction->read_data_.resize(offset + step.value);
+        err = this->read(transaction->address_, transaction->read_data_.data() + offset, step.value);
+      }
+      this->busy_time_us_ += micros() - start;
+
+      if (err != ERROR_OK) {
+        transaction->error_ = err;
+        transaction->next_step_ = transaction->steps_.size();
+      }
+    }
+  }
+
+  auto finished = std::stable_partition(
+      this->active_transactions_.begin(), this->active_transactions_.end(),
+      [](const std::unique_ptr<I2CTransaction> &transaction) { return !transaction->is_done_(); });
+  if (finished != this->active_transactions_.end()) {
+    LockGuard guard(this->transaction_lock_);
+    for (auto it = finished; it != this->active_transactions_.end(); ++it)
+      this->finished_transactions_.push_back(std::move(*it));
+  }
+  this->active_transactions_.erase(finished, this->active_transactions_.end());
+  return next_due;
+}
+
+void I2CBus::complete_transactions_() {
+  std::vector<std::unique_ptr<I2CTransaction>> finished;
+  {
+    LockGuard guard(this->transaction_lock_);
+    if (this->finished_transactions_.empty())
+      return;
+    finished.swap(this->finished_transactions_);
+  }
+  const uint32_t now = millis();
+  for (auto &transaction : finished) {
+    this->transaction_count_++;
+    if (transaction->error_ != ERROR_OK) {
+      ESP_LOGV(TAG, "Transaction for address 0x%02X failed: %d", transaction->address_, transaction->error_);
+      this->failed_transaction_count_++;
+    }
+    if (transaction->error_ == ERROR_TIMEOUT)
+      this->timeout_count_++;
+    this->max_transaction_latency_ = std::max(this->max_transaction_latency_, now - transaction->submitted_at_);
+    if (transaction->callback_)
+      transaction->callback_(transaction->error_, transaction->read_data_);
+  }
+}
+
+float I2CBus::get_bus_utilisation() const {
+  uint32_t uptime = millis();
+  if (uptime == 0)
+    return 0.0f;
+  LockGuard guard(this->bus_lock_);
+  return float(this->busy_time_us_ / 1000) / float(uptime);
+}
+
+}  // namespace i2c
+}  // namespace esphome
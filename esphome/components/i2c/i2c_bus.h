@@ -1,9 +1,13 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "esphome/core/helpers.h"
+
 namespace esphome {
 namespace i2c {
 
@@ -27,8 +31,70 @@ struct WriteBuffer {
   size_t len;
 };
 
+/** A chain of writes, reads and delays that is executed on the bus without blocking the caller.
+ *
+ * The data of all read steps is concatenated and handed to the completion callback. The callback is always
+ * called from the main loop.
+ */
+class I2CTransaction {
+ public:
+  using callback_t = std::function<void(ErrorCode error, const std::vector<uint8_t> &data)>;
+
+  explicit I2CTransaction(uint8_t address) : address_(address) {}
+
+  I2CTransaction &write(const uint8_t *data, size_t len, bool stop = true) {
+    this->steps_.push_back({STEP_WRITE, stop, 0, std::vector<uint8_t>(data, data + len)});
+    return *this;
+  }
+  I2CTransaction &write(std::vector<uint8_t> data, bool stop = true) {
+    this->steps_.push_back({STEP_WRITE, stop, 0, std::move(data)});
+    return *this;
+  }
+  I2CTransaction &read(size_t len) {
+    this->steps_.push_back({STEP_READ, true, static_cast<uint32_t>(len), {}});
+    return *this;
+  }
+  /// Let the bus serve other transactions for the given time, e.g. while the device is converting.
+  I2CTransaction &delay(uint32_t ms) {
+    this->steps_.push_back({STEP_DELAY, true, ms, {}});
+    return *this;
+  }
+  I2CTransaction &on_complete(callback_t &&callback) {
+    this->callback_ = std::move(callback);
+    return *this;
+  }
+
+ protected:
+  friend class I2CBus;
+
+  enum StepType : uint8_t {
+    STEP_WRITE,
+    STEP_READ,
+    STEP_DELAY,
+  };
+  struct Step {
+    StepType type;
+    bool stop;
+    uint32_t value;  ///< number of bytes for reads, milliseconds for delays
+    std::vector<uint8_t> data;
+  };
+
+  bool is_done_() const { return this->next_step_ >= this->steps_.size(); }
+
+  uint8_t address_;
+  std::vector<Step> steps_;
+  size_t next_step_{0};
+  uint32_t resume_at_{0};
+  uint32_t submitted_at_{0};
+  std::vector<uint8_t> read_data_;
+  ErrorCode error_{ERROR_OK};
+  callback_t callback_;
+};
+
 class I2CBus {
  public:
+  virtual ~I2CBus() = default;
+
   virtual ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) {
     ReadBuffer buf;
     buf.data = buffer;
@@ -50,7 +116,46 @@ class I2CBus {
   }
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) = 0;
 
+  /// Queue a transaction. Transactions of different devices are run back to back, and while one waits in a delay
+  /// step the others continue.
+  void submit(I2CTransaction &&transaction);
+
+  uint32_t get_transaction_count() const { return this->transaction_count_; }
+  uint32_t get_failed_transaction_count() const { return this->failed_transaction_count_; }
+  uint32_t get_timeout_count() const { return this->timeout_count_; }
+  /// Longest time in ms between submitting a transaction and its completion
+  uint32_t get_max_transaction_latency() const { return this->max_transaction_latency_; }
+  /// Fraction of time since boot spent transferring data of queued transactions
+  float get_bus_utilisation() const;
+
+  /// Lock that serializes the transfers of the main loop with the transactions run by a worker task. Hold it across
+  /// transfers that must not be split up, like a write without stop and the read that follows it.
+  Mutex &get_lock() { return this->bus_lock_; }
+
  protected:
+  /// Run every transaction step that is due. Returns the time in ms until the next delay expires,
+  /// or UINT32_MAX if no transaction is waiting.
+  uint32_t run_transactions_();
+  /// Hand finished transactions to their callbacks, must be called from the main loop.
+  void complete_transactions_();
+  /// Called after a transaction was queued, so a bus running transactions in a worker can wake it up.
+  virtual void on_transaction_submitted_() {}
+
+  Mutex transaction_lock_;
+  /// queued by submit(), guarded by transaction_lock_
+  std::vector<std::unique_ptr<I2CTransaction>> submitted_transactions_;
+  /// only accessed by whoever runs the transactions
+  std::vector<std::unique_ptr<I2CTransaction>> active_transactions_;
+  /// guarded by transaction_lock_
+  std::vector<std::unique_ptr<I2CTransaction>> finished_transactions_;
+  uint32_t transaction_count_{0};
+  uint32_t failed_transaction_count_{0};
+  uint32_t timeout_count_{0};
+  uint32_t max_transaction_latency_{0};
+  mutable Mutex bus_lock_;
+  /// guarded by bus_lock_
+  uint64_t busy_time_us_{0};
+
   void i2c_scan_() {
     for (uint8_t address = 8; address < 120; address++) {
       auto err = writev(address, nullptr, 0);
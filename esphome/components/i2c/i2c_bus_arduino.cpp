@@ -81,6 +81,11 @@ void ArduinoI2CBus::dump_config() {
   }
 }
 
+void ArduinoI2CBus::loop() {
+  this->run_transactions_();
+  this->complete_transactions_();
+}
+
 ErrorCode ArduinoI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
   // logging is only enabled with vv level, if warnings are shown the caller
   // should log them
@@ -5,6 +5,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/application.h"
+#include <algorithm>
 #include <cstring>
 #include <cinttypes>
 
@@ -89,6 +90,36 @@ void IDFI2CBus::dump_config() {
   }
 }
 
+void IDFI2CBus::loop() {
+  // without a worker task the transactions run on the main loop
+  if (this->transaction_task_handle_ == nullptr)
+    this->run_transactions_();
+  this->complete_transactions_();
+}
+
+void IDFI2CBus::on_transaction_submitted_() {
+  if (this->transaction_task_handle_ != nullptr) {
+    xTaskNotifyGive(this->transaction_task_handle_);
+    return;
+  }
+  // the worker is only created once a device actually submits a transaction
+  if (xTaskCreate(IDFI2CBus::transaction_task, "i2c_task", 3072, this, 1, &this->transaction_task_handle_) != pdPASS) {
+    ESP_LOGW(TAG, "Could not create I2C transaction task, running transactions from the main loop");
+    this->transaction_task_handle_ = nullptr;
+  }
+}
+
+void IDFI2CBus::transaction_task(void *params) {
+  IDFI2CBus *this_bus = (IDFI2CBus *) params;
+  while (true) {
+    uint32_t next_due = this_bus->run_transactions_();
+    TickType_t wait = portMAX_DELAY;
+    if (next_due != UINT32_MAX)
+      wait = std::max<TickType_t>(1, pdMS_TO_TICKS(next_due));
+    ulTaskNotifyTake(pdTRUE, wait);
+  }
+}
+
 ErrorCode IDFI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
   // logging is only enabled with vv level, if warnings are shown the caller
   // should log them
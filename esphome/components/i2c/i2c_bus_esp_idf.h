@@ -5,6 +5,8 @@
 #include "i2c_bus.h"
 #include "esphome/core/component.h"
 #include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 namespace esphome {
 namespace i2c {
@@ -19,6 +21,7 @@ class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void loop() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
   float get_setup_priority() const override { return setup_priority::BUS; }
@@ -42,6 +45,10 @@ class IDFI2CBus : public I2CBus, public Component {
   bool scl_pullup_enabled_;
   uint32_t frequency_;
   bool initialized_ = false;
+
+  void on_transaction_submitted_() override;
+  static void transaction_task(void *params);
+  TaskHandle_t transaction_task_handle_{nullptr};
 };
 
 }  // namespace i2c
@@ -7,10 +7,15 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_SIZE = 512;
+/// Size of the ring buffer between the read task and the consumer, 256ms of 16-bit audio at 16kHz
+static const size_t RING_BUFFER_SIZE = 8192;
+/// Maximum number of samples read from I2S at once
+static const size_t READ_BLOCK_SAMPLES = 256;
 
 static const char *const TAG = "i2s_audio.microphone";
 
@@ -32,6 +37,13 @@ void I2SAudioMicrophone::setup() {
       return;
     }
   }
+
+  this->ring_buffer_ = RingBuffer::create(RING_BUFFER_SIZE);
+  if (this->ring_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate ring buffer");
+    this->mark_failed();
+    return;
+  }
 }
 
 void I2SAudioMicrophone::start() {
@@ -81,6 +93,12 @@ void I2SAudioMicrophone::start_() {
 
     i2s_set_pin(this->parent_->get_port(), &pin_config);
   }
+
+  this->ring_buffer_->reset();
+  this->stop_task_ = false;
+  this->task_running_ = true;
+  xTaskCreate(I2SAudioMicrophone::read_task, "mic_task", 4096, (void *) this, 5, &this->read_task_handle_);
+
   this->state_ = microphone::STATE_RUNNING;
   this->high_freq_.start();
 }
@@ -96,6 +114,10 @@ void I2SAudioMicrophone::stop() {
 }
 
 void I2SAudioMicrophone::stop_() {
+  this->stop_task_ = true;
+  if (this->task_running_)
+    return;  // Waiting for the read task to finish its current block
+  this->read_task_handle_ = nullptr;
   i2s_stop(this->parent_->get_port());
   i2s_driver_uninstall(this->parent_->get_port());
   this->parent_->unlock();
@@ -103,43 +125,70 @@ void I2SAudioMicrophone::stop_() {
   this->high_freq_.stop();
 }
 
-size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
-  size_t bytes_read = 0;
-  esp_err_t err = i2s_read(this->parent_->get_port(), buf, len, &bytes_read, (100 / portTICK_PERIOD_MS));
-  if (err != ESP_OK) {
-    ESP_LOGW(TAG, "Error reading from I2S microphone: %s", esp_err_to_name(err));
-    this->status_set_warning();
-    return 0;
+// Plain loop over contiguous arrays without data dependent branches, so the compiler can unroll and vectorize it
+static void convert_32_to_16(const int32_t *src, int16_t *dst, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    int32_t sample = src[i] >> 14;
+    dst[i] = static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(sample, INT16_MIN), INT16_MAX));
   }
-  if (bytes_read == 0) {
-    this->status_set_warning();
-    return 0;
+}
+
+void I2SAudioMicrophone::read_task(void *params) {
+  auto *this_mic = static_cast<I2SAudioMicrophone *>(params);
+  while (!this_mic->stop_task_) {
+    this_mic->read_failed_ = !this_mic->read_block_();
+  }
+  this_mic->task_running_ = false;
+  vTaskDelete(nullptr);
+}
+
+bool I2SAudioMicrophone::read_block_() {
+  int32_t block[READ_BLOCK_SAMPLES];
+  size_t bytes_read = 0;
+
+  size_t span_len;
+  auto *span = reinterpret_cast<int16_t *>(this->ring_buffer_->write_span(&span_len));
+  size_t samples = std::min(span_len / sizeof(int16_t), READ_BLOCK_SAMPLES);
+  if (samples == 0) {
+    // Consumer is behind, keep draining the DMA buffers and discard the audio
+    this->overrun_count_++;
+    return i2s_read(this->parent_->get_port(), block, sizeof(block), &bytes_read, (100 / portTICK_PERIOD_MS)) ==
+           ESP_OK;
   }
-  this->status_clear_warning();
+
+  esp_err_t err;
   if (this->bits_per_sample_ == I2S_BITS_PER_SAMPLE_16BIT) {
-    return bytes_read;
-  } else if (this->bits_per_sample_ == I2S_BITS_PER_SAMPLE_32BIT) {
-    std::vector<int16_t> samples;
-    size_t samples_read = bytes_read / sizeof(int32_t);
-    samples.resize(samples_read);
-    for (size_t i = 0; i < samples_read; i++) {
-      int32_t temp = reinterpret_cast<int32_t *>(buf)[i] >> 14;
-      samples[i] = clamp<int16_t>(temp, INT16_MIN, INT16_MAX);
-    }
-    memcpy(buf, samples.data(), samples_read * sizeof(int16_t));
-    return samples_read * sizeof(int16_t);
+    // DMA data goes straight into the ring buffer
+    err = i2s_read(this->parent_->get_port(), span, samples * sizeof(int16_t), &bytes_read,
+                   (100 / portTICK_PERIOD_MS));
+    bytes_read -= bytes_read % sizeof(int16_t);
   } else {
-    ESP_LOGE(TAG, "Unsupported bits per sample: %d", this->bits_per_sample_);
-    return 0;
+    err = i2s_read(this->parent_->get_port(), block, samples * sizeof(int32_t), &bytes_read,
+                   (100 / portTICK_PERIOD_MS));
+    size_t samples_read = bytes_read / sizeof(int32_t);
+    convert_32_to_16(block, span, samples_read);
+    bytes_read = samples_read * sizeof(int16_t);
   }
+  if (err != ESP_OK || bytes_read == 0)
+    return false;
+  this->ring_buffer_->commit_write(bytes_read);
+  return true;
+}
+
+size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
+  if (this->ring_buffer_ == nullptr)
+    return 0;
+  return this->ring_buffer_->read(buf, len - len % sizeof(int16_t));
 }
 
 void I2SAudioMicrophone::read_() {
-  std::vector<int16_t> samples;
-  samples.resize(BUFFER_SIZE);
-  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE / sizeof(int16_t));
-  samples.resize(bytes_read / sizeof(int16_t));
-  this->data_callbacks_.call(samples);
+  size_t available = this->ring_buffer_->available() / sizeof(int16_t);
+  if (available == 0)
+    return;
+  this->callback_samples_.resize(available);
+  size_t bytes_read = this->ring_buffer_->read(this->callback_samples_.data(), available * sizeof(int16_t));
+  this->callback_samples_.resize(bytes_read / sizeof(int16_t));
+  this->data_callbacks_.call(this->callback_samples_);
 }
 
 void I2SAudioMicrophone::loop() {
@@ -150,6 +199,11 @@ void I2SAudioMicrophone::loop() {
       this->start_();
       break;
     case microphone::STATE_RUNNING:
+      if (this->read_failed_) {
+        this->status_set_warning();
+      } else {
+        this->status_clear_warning();
+      }
       if (this->data_callbacks_.size() > 0) {
         this->read_();
       }
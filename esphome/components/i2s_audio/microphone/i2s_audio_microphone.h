@@ -7,6 +7,12 @@
 #include "esphome/components/microphone/microphone.h"
 #include "esphome/core/component.h"
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <vector>
+
 namespace esphome {
 namespace i2s_audio {
 
@@ -33,11 +39,19 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   void set_channel(i2s_channel_fmt_t channel) { this->channel_ = channel; }
   void set_bits_per_sample(i2s_bits_per_sample_t bits_per_sample) { this->bits_per_sample_ = bits_per_sample; }
 
+  /// Number of times captured audio was discarded because the ring buffer was full.
+  uint32_t get_overrun_count() const { return this->overrun_count_; }
+
  protected:
   void start_();
   void stop_();
   void read_();
 
+  /// Reads the I2S DMA buffers straight into the ring buffer until stop_task_ is set.
+  static void read_task(void *params);
+  /// Read one block from I2S into the ring buffer, returns false if the read failed.
+  bool read_block_();
+
   int8_t din_pin_{I2S_PIN_NO_CHANGE};
 #if SOC_I2S_SUPPORTS_ADC
   adc1_channel_t adc_channel_{ADC1_CHANNEL_MAX};
@@ -48,6 +62,14 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   i2s_bits_per_sample_t bits_per_sample_;
 
   HighFrequencyLoopRequester high_freq_;
+
+  TaskHandle_t read_task_handle_{nullptr};
+  std::atomic<bool> stop_task_{false};
+  std::atomic<bool> task_running_{false};
+  std::atomic<bool> read_failed_{false};
+  std::atomic<uint32_t> overrun_count_{0};
+  /// samples passed to the data callbacks, kept to avoid an allocation per read
+  std::vector<int16_t> callback_samples_;
 };
 
 }  // namespace i2s_audio
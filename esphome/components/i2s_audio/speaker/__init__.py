@@ -1,8 +1,15 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import pins
-from esphome.const import CONF_ID, CONF_MODE
-from esphome.components import esp32, speaker
+from esphome.const import (
+    CONF_ID,
+    CONF_MODE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+from esphome.components import esp32, sensor, speaker
 
 from .. import (
     CONF_I2S_AUDIO_ID,
@@ -14,6 +21,7 @@ from .. import (
 
 CODEOWNERS = ["@jesserockz"]
 DEPENDENCIES = ["i2s_audio"]
+AUTO_LOAD = ["sensor"]
 
 I2SAudioSpeaker = i2s_audio_ns.class_(
     "I2SAudioSpeaker", cg.Component, speaker.Speaker, I2SAudioOut
@@ -23,6 +31,10 @@ i2s_dac_mode_t = cg.global_ns.enum("i2s_dac_mode_t")
 
 CONF_MUTE_PIN = "mute_pin"
 CONF_DAC_TYPE = "dac_type"
+CONF_BUFFER_DURATION = "buffer_duration"
+CONF_PREBUFFER = "prebuffer"
+CONF_UNDERRUNS = "underruns"
+CONF_BUFFER_LATENCY = "buffer_latency"
 
 INTERNAL_DAC_OPTIONS = {
     "left": i2s_dac_mode_t.I2S_DAC_CHANNEL_LEFT_EN,
@@ -44,20 +56,49 @@ def validate_esp32_variant(config):
     return config
 
 
+BASE_SCHEMA = speaker.SPEAKER_SCHEMA.extend(
+    {
+        cv.GenerateID(): cv.declare_id(I2SAudioSpeaker),
+        cv.GenerateID(CONF_I2S_AUDIO_ID): cv.use_id(I2SAudioComponent),
+        cv.Optional(
+            CONF_BUFFER_DURATION, default="500ms"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(
+            CONF_PREBUFFER, default="50ms"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_UNDERRUNS): sensor.sensor_schema(
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_TOTAL_INCREASING,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_BUFFER_LATENCY): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            accuracy_decimals=0,
+            state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+).extend(cv.COMPONENT_SCHEMA)
+
+
+def validate_prebuffer(config):
+    if config[CONF_PREBUFFER] >= config[CONF_BUFFER_DURATION]:
+        raise cv.Invalid(
+            f"{CONF_PREBUFFER} must be shorter than {CONF_BUFFER_DURATION}"
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.typed_schema(
         {
-            "internal": speaker.SPEAKER_SCHEMA.extend(
+            "internal": BASE_SCHEMA.extend(
                 {
-                    cv.GenerateID(): cv.declare_id(I2SAudioSpeaker),
-                    cv.GenerateID(CONF_I2S_AUDIO_ID): cv.use_id(I2SAudioComponent),
                     cv.Required(CONF_MODE): cv.enum(INTERNAL_DAC_OPTIONS, lower=True),
                 }
-            ).extend(cv.COMPONENT_SCHEMA),
-            "external": speaker.SPEAKER_SCHEMA.extend(
+            ),
+            "external": BASE_SCHEMA.extend(
                 {
-                    cv.GenerateID(): cv.declare_id(I2SAudioSpeaker),
-                    cv.GenerateID(CONF_I2S_AUDIO_ID): cv.use_id(I2SAudioComponent),
                     cv.Required(
                         CONF_I2S_DOUT_PIN
                     ): pins.internal_gpio_output_pin_number,
@@ -65,11 +106,12 @@ CONFIG_SCHEMA = cv.All(
                         *EXTERNAL_DAC_OPTIONS, lower=True
                     ),
                 }
-            ).extend(cv.COMPONENT_SCHEMA),
+            ),
         },
         key=CONF_DAC_TYPE,
     ),
     validate_esp32_variant,
+    validate_prebuffer,
 )
 
 
@@ -85,3 +127,13 @@ async def to_code(config):
     else:
         cg.add(var.set_dout_pin(config[CONF_I2S_DOUT_PIN]))
         cg.add(var.set_external_dac_channels(2 if config[CONF_MODE] == "stereo" else 1))
+
+    cg.add(var.set_buffer_duration(config[CONF_BUFFER_DURATION]))
+    cg.add(var.set_prebuffer_duration(config[CONF_PREBUFFER]))
+
+    if CONF_UNDERRUNS in config:
+        sens = await sensor.new_sensor(config[CONF_UNDERRUNS])
+        cg.add(var.set_underruns_sensor(sens))
+    if CONF_BUFFER_LATENCY in config:
+        sens = await sensor.new_sensor(config[CONF_BUFFER_LATENCY])
+        cg.add(var.set_buffer_latency_sensor(sens))
@@ -8,26 +8,59 @@
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_COUNT = 20;
+static const size_t EVENT_QUEUE_SIZE = 20;
+static const uint32_t SAMPLE_RATE = 16000;
+static const uint32_t BYTES_PER_MS = SAMPLE_RATE * sizeof(int16_t) / 1000;
+/// Number of samples converted and written to I2S at once
+static const size_t BLOCK_SAMPLES = 256;
+/// Playback ends when no new audio arrived for this long
+static const uint32_t IDLE_TIMEOUT_MS = 100;
 
 static const char *const TAG = "i2s_audio.speaker";
 
 void I2SAudioSpeaker::setup() {
   ESP_LOGCONFIG(TAG, "Setting up I2S Audio Speaker...");
 
-  this->buffer_queue_ = xQueueCreate(BUFFER_COUNT, sizeof(DataEvent));
-  this->event_queue_ = xQueueCreate(BUFFER_COUNT, sizeof(TaskEvent));
+  this->event_queue_ = xQueueCreate(EVENT_QUEUE_SIZE, sizeof(TaskEvent));
+  this->ring_buffer_ = RingBuffer::create(this->buffer_duration_ * BYTES_PER_MS);
+  if (this->ring_buffer_ == nullptr) {
+    ESP_LOGE(TAG, "Could not allocate audio buffer");
+    this->mark_failed();
+    return;
+  }
+
+  if (this->underruns_sensor_ != nullptr || this->buffer_latency_sensor_ != nullptr) {
+    this->set_interval("stats", 1000, [this]() {
+      if (this->underruns_sensor_ != nullptr)
+        this->underruns_sensor_->publish_state(this->underrun_count_);
+      if (this->buffer_latency_sensor_ != nullptr)
+        this->buffer_latency_sensor_->publish_state(this->get_buffer_latency());
+    });
+  }
+}
+
+uint32_t I2SAudioSpeaker::get_buffer_latency() const {
+  if (this->ring_buffer_ == nullptr)
+    return 0;
+  return this->ring_buffer_->available() / BYTES_PER_MS;
 }
 
-void I2SAudioSpeaker::start() { this->state_ = speaker::STATE_STARTING; }
+void I2SAudioSpeaker::start() {
+  if (this->is_failed())
+    return;
+  this->state_ = speaker::STATE_STARTING;
+}
 void I2SAudioSpeaker::start_() {
   if (!this->parent_->try_lock()) {
     return;  // Waiting for another i2s component to return lock
   }
   this->state_ = speaker::STATE_RUNNING;
+  this->stop_requested_ = false;
 
   xTaskCreate(I2SAudioSpeaker::player_task, "speaker_task", 8192, (void *) this, 0, &this->player_task_handle_);
 }
@@ -85,44 +118,57 @@ void I2SAudioSpeaker::player_task(void *params) {
   }
 #endif
 
-  DataEvent data_event;
-
   event.type = TaskEventType::STARTED;
   xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
 
-  int16_t buffer[BUFFER_SIZE / 2];
-
-  while (true) {
-    if (xQueueReceive(this_speaker->buffer_queue_, &data_event, 100 / portTICK_PERIOD_MS) != pdTRUE) {
-      break;  // End of audio from main thread
+  RingBuffer *ring = this_speaker->ring_buffer_.get();
+  const size_t prebuffer = this_speaker->prebuffer_duration_ * BYTES_PER_MS;
+  bool playing = false;
+  bool underrun = false;
+  size_t last_available = 0;
+  uint32_t last_data = millis();
+
+  while (!this_speaker->stop_requested_) {
+    size_t available = ring->available();
+    if (available != last_available) {
+      last_available = available;
+      last_data = millis();
     }
-    if (data_event.stop) {
-      // Stop signal from main thread
-      xQueueReset(this_speaker->buffer_queue_);  // Flush queue
-      break;
-    }
-    size_t bytes_written;
-
-    memmove(buffer, data_event.data, data_event.len);
-    size_t remaining = data_event.len / 2;
-    size_t current = 0;
-
-    while (remaining > 0) {
-      uint32_t sample = (buffer[current] << 16) | (buffer[current] & 0xFFFF);
 
-      esp_err_t err = i2s_write(this_speaker->parent_->get_port(), &sample, sizeof(sample), &bytes_written,
-                                (10 / portTICK_PERIOD_MS));
-      if (err != ESP_OK) {
-        event = {.type = TaskEventType::WARNING, .err = err};
-        xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
+    if (!playing) {
+      // Wait until enough audio is buffered, or play what's there once no more audio arrives
+      bool idle = millis() - last_data >= IDLE_TIMEOUT_MS;
+      if (available == 0 && idle)
+        break;  // End of audio from main thread
+      if (available < prebuffer && !idle) {
+        delay(1);
         continue;
       }
-      remaining--;
-      current++;
+      playing = true;
+      if (underrun) {
+        this_speaker->underrun_count_++;
+        underrun = false;
+      }
+      event.type = TaskEventType::PLAYING;
+      xQueueSend(this_speaker->event_queue_, &event, 0);
+    }
+
+    size_t len;
+    const auto *samples = reinterpret_cast<const int16_t *>(ring->read_span(&len));
+    size_t count = std::min(len / sizeof(int16_t), BLOCK_SAMPLES);
+    if (count == 0) {
+      // Ran out of audio, buffer again before resuming so playback doesn't stutter
+      playing = false;
+      underrun = true;
+      continue;
     }
 
-    event.type = TaskEventType::PLAYING;
-    xQueueSend(this_speaker->event_queue_, &event, portMAX_DELAY);
+    esp_err_t err = this_speaker->write_block_(samples, count);
+    ring->commit_read(count * sizeof(int16_t));
+    if (err != ESP_OK) {
+      event = {.type = TaskEventType::WARNING, .err = err};
+      xQueueSend(this_speaker->event_queue_, &event, 0);
+    }
   }
 
   i2s_zero_dma_buffer(this_speaker->parent_->get_port());
@@ -140,6 +186,18 @@ void I2SAudioSpeaker::player_task(void *params) {
   }
 }
 
+esp_err_t I2SAudioSpeaker::write_block_(const int16_t *samples, size_t count) {
+  uint32_t block[BLOCK_SAMPLES];
+  const int32_t volume = static_cast<int32_t>(this->volume_ * 32768.0f);
+  // Scale each sample and duplicate it into both channels
+  for (size_t i = 0; i < count; i++) {
+    uint16_t sample = static_cast<uint16_t>((int32_t(samples[i]) * volume) >> 15);
+    block[i] = (uint32_t(sample) << 16) | sample;
+  }
+  size_t bytes_written;
+  return i2s_write(this->parent_->get_port(), block, count * sizeof(uint32_t), &bytes_written, portMAX_DELAY);
+}
+
 void I2SAudioSpeaker::stop() {
   if (this->state_ == speaker::STATE_STOPPED)
     return;
@@ -148,9 +206,7 @@ void I2SAudioSpeaker::stop() {
     return;
   }
   this->state_ = speaker::STATE_STOPPING;
-  DataEvent data;
-  data.stop = true;
-  xQueueSendToFront(this->buffer_queue_, &data, portMAX_DELAY);
+  this->stop_requested_ = true;
 }
 
 void I2SAudioSpeaker::watch_() {
@@ -174,7 +230,7 @@ void I2SAudioSpeaker::watch_() {
         vTaskDelete(this->player_task_handle_);
         this->player_task_handle_ = nullptr;
         this->parent_->unlock();
-        xQueueReset(this->buffer_queue_);
+        this->ring_buffer_->reset();
         ESP_LOGD(TAG, "Stopped I2S Audio Speaker");
         break;
       case TaskEventType::WARNING:
@@ -200,24 +256,13 @@ void I2SAudioSpeaker::loop() {
 }
 
 size_t I2SAudioSpeaker::play(const uint8_t *data, size_t length) {
+  if (this->is_failed())
+    return 0;
   if (this->state_ != speaker::STATE_RUNNING && this->state_ != speaker::STATE_STARTING) {
     this->start();
   }
-  size_t remaining = length;
-  size_t index = 0;
-  while (remaining > 0) {
-    DataEvent event;
-    event.stop = false;
-    size_t to_send_length = std::min(remaining, BUFFER_SIZE);
-    event.len = to_send_length;
-    memcpy(event.data, data + index, to_send_length);
-    if (xQueueSend(this->buffer_queue_, &event, 0) != pdTRUE) {
-      return index;
-    }
-    remaining -= to_send_length;
-    index += to_send_length;
-  }
-  return index;
+  // Only whole samples, so the player task never sees half of one
+  return this->ring_buffer_->write(data, length - length % sizeof(int16_t));
 }
 
 }  // namespace i2s_audio
@@ -8,16 +8,19 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
 
+#include "esphome/components/sensor/sensor.h"
 #include "esphome/components/speaker/speaker.h"
 #include "esphome/core/component.h"
 #include "esphome/core/gpio.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/ring_buffer.h"
+
+#include <atomic>
+#include <memory>
 
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_SIZE = 1024;
-
 enum class TaskEventType : uint8_t {
   STARTING = 0,
   STARTED,
@@ -32,12 +35,6 @@ struct TaskEvent {
   esp_err_t err;
 };
 
-struct DataEvent {
-  bool stop;
-  size_t len;
-  uint8_t data[BUFFER_SIZE];
-};
-
 class I2SAudioSpeaker : public Component, public speaker::Speaker, public I2SAudioOut {
  public:
   float get_setup_priority() const override { return esphome::setup_priority::LATE; }
@@ -50,6 +47,23 @@ class I2SAudioSpeaker : public Component, public speaker::Speaker, public I2SAud
   void set_internal_dac_mode(i2s_dac_mode_t mode) { this->internal_dac_mode_ = mode; }
 #endif
   void set_external_dac_channels(uint8_t channels) { this->external_dac_channels_ = channels; }
+  /// Set how much audio in milliseconds can be buffered ahead of playback.
+  void set_buffer_duration(uint32_t buffer_duration) { this->buffer_duration_ = buffer_duration; }
+  /// Set how much audio in milliseconds is buffered before playback starts or resumes after an underrun.
+  void set_prebuffer_duration(uint32_t prebuffer_duration) { this->prebuffer_duration_ = prebuffer_duration; }
+  /// Set the playback volume, from 0.0 to 1.0.
+  void set_volume(float volume) { this->volume_ = clamp(volume, 0.0f, 1.0f); }
+  float get_volume() const { return this->volume_; }
+
+  void set_underruns_sensor(sensor::Sensor *underruns_sensor) { this->underruns_sensor_ = underruns_sensor; }
+  void set_buffer_latency_sensor(sensor::Sensor *buffer_latency_sensor) {
+    this->buffer_latency_sensor_ = buffer_latency_sensor;
+  }
+
+  /// Number of times playback ran out of buffered audio and had to wait for more.
+  uint32_t get_underrun_count() const { return this->underrun_count_; }
+  /// Duration of the audio that is buffered but not yet written to I2S, in milliseconds.
+  uint32_t get_buffer_latency() const;
 
   void start() override;
   void stop() override;
@@ -62,10 +76,20 @@ class I2SAudioSpeaker : public Component, public speaker::Speaker, public I2SAud
   void watch_();
 
   static void player_task(void *params);
+  /// Convert a block of mono samples to the stereo I2S format with the volume applied, then write it.
+  esp_err_t write_block_(const int16_t *samples, size_t count);
 
   TaskHandle_t player_task_handle_{nullptr};
-  QueueHandle_t buffer_queue_;
   QueueHandle_t event_queue_;
+  std::unique_ptr<RingBuffer> ring_buffer_;
+  std::atomic<bool> stop_requested_{false};
+  std::atomic<uint32_t> underrun_count_{0};
+  std::atomic<float> volume_{1.0f};
+  uint32_t buffer_duration_{500};
+  uint32_t prebuffer_duration_{50};
+
+  sensor::Sensor *underruns_sensor_{nullptr};
+  sensor::Sensor *buffer_latency_sensor_{nullptr};
 
   uint8_t dout_pin_{0};
 
@@ -4,6 +4,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ili9xxx {
 
@@ -113,41 +115,82 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0) {
     return;
   }
-  uint32_t pos = (y * width_) + x;
-  uint16_t new_color;
+  if (this->set_pixel_((y * width_) + x, this->convert_color_(color))) {
+    this->mark_dirty_(x, y, x, y);
+  }
+}
+
+void HOT ILI9XXXDisplay::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const int x2 = std::min(x + width, this->get_width_internal());
+  const int y2 = std::min(y + height, this->get_height_internal());
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (x >= x2 || y >= y2)
+    return;
+
+  // convert the color once for the whole rectangle
+  const uint16_t value = this->convert_color_(color);
   bool updated = false;
+  for (int row = y; row < y2; row++) {
+    const uint32_t start = row * width_;
+    for (uint32_t pos = start + x; pos < start + x2; pos++)
+      updated |= this->set_pixel_(pos, value);
+  }
+  if (updated)
+    this->mark_dirty_(x, y, x2 - 1, y2 - 1);
+}
+
+void HOT ILI9XXXDisplay::draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) {
+  const int end_x = x + dx * (len - 1);
+  const int end_y = y + dy * (len - 1);
+  if (std::min(x, end_x) < 0 || std::max(x, end_x) >= this->get_width_internal() || std::min(y, end_y) < 0 ||
+      std::max(y, end_y) >= this->get_height_internal()) {
+    display::DisplayBuffer::draw_absolute_span_internal(x, y, dx, dy, colors, len);
+    return;
+  }
+
+  const int step = dy * width_ + dx;
+  uint32_t pos = y * width_ + x;
+  bool updated = false;
+  for (int i = 0; i < len; i++, pos += step)
+    updated |= this->set_pixel_(pos, this->convert_color_(colors[i]));
+  if (updated)
+    this->mark_dirty_(std::min(x, end_x), std::min(y, end_y), std::max(x, end_x), std::max(y, end_y));
+}
+
+uint16_t ILI9XXXDisplay::convert_color_(Color color) const {
   switch (this->buffer_color_mode_) {
     case BITS_8_INDEXED:
-      new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
-      break;
+      return display::ColorUtil::color_to_index8_palette888(color, this->palette_);
     case BITS_16:
-      pos = pos * 2;
-      new_color = display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
-      if (this->buffer_[pos] != (uint8_t) (new_color >> 8)) {
-        this->buffer_[pos] = (uint8_t) (new_color >> 8);
-        updated = true;
-      }
-      pos = pos + 1;
-      new_color = new_color & 0xFF;
-      break;
+      return display::ColorUtil::color_to_565(color, display::ColorOrder::COLOR_ORDER_RGB);
     default:
-      new_color = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
-      break;
+      return display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
   }
+}
 
-  if (this->buffer_[pos] != new_color) {
-    this->buffer_[pos] = new_color;
-    updated = true;
-  }
-  if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    this->x_low_ = (x < this->x_low_) ? x : this->x_low_;
-    this->y_low_ = (y < this->y_low_) ? y : this->y_low_;
-    this->x_high_ = (x > this->x_high_) ? x : this->x_high_;
-    this->y_high_ = (y > this->y_high_) ? y : this->y_high_;
-    // ESP_LOGVV(TAG, "=>>> pixel (x:%d, y:%d) (xl:%d, xh:%d, yl:%d, yh:%d", x, y, this->x_low_, this->x_high_,
-    //           this->y_low_, this->y_high_);
-  }
+bool HOT ILI9XXXDisplay::set_pixel_(uint32_t pos, uint16_t value) {
+  if (this->buffer_color_mode_ == BITS_16) {
+    pos = pos * 2;
+    const uint8_t high = value >> 8, low = value & 0xFF;
+    if (this->buffer_[pos] == high && this->buffer_[pos + 1] == low)
+      return false;
+    this->buffer_[pos] = high;
+    this->buffer_[pos + 1] = low;
+    return true;
+  }
+  if (this->buffer_[pos] == value)
+    return false;
+  this->buffer_[pos] = value;
+  return true;
+}
+
+void ILI9XXXDisplay::mark_dirty_(int x1, int y1, int x2, int y2) {
+  // low and high watermark may speed up drawing from buffer
+  this->x_low_ = (x1 < this->x_low_) ? x1 : this->x_low_;
+  this->y_low_ = (y1 < this->y_low_) ? y1 : this->y_low_;
+  this->x_high_ = (x2 > this->x_high_) ? x2 : this->x_high_;
+  this->y_high_ = (y2 > this->y_high_) ? y2 : this->y_high_;
 }
 
 void ILI9XXXDisplay::update() {
@@ -184,15 +227,14 @@ void ILI9XXXDisplay::display_() {
            this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, start_pos);
 
   this->start_data_();
-  for (uint16_t row = 0; row < h; row++) {
-    uint32_t pos = start_pos + (row * width_);
-    uint32_t rem = w;
-
-    while (rem > 0) {
-      uint32_t sz = std::min(rem, ILI9XXX_TRANSFER_BUFFER_SIZE);
-      // ESP_LOGVV(TAG, "Send to display(pos:%d, rem:%d, zs:%d)", pos, rem, sz);
-      buffer_to_transfer_(pos, sz);
-      if (this->is_18bitdisplay_) {
+  if (this->is_18bitdisplay_) {
+    for (uint16_t row = 0; row < h; row++) {
+      uint32_t pos = start_pos + (row * width_);
+      uint32_t rem = w;
+
+      while (rem > 0) {
+        uint32_t sz = std::min(rem, ILI9XXX_TRANSFER_BUFFER_SIZE);
+        buffer_to_transfer_(pos, sz);
         for (uint32_t i = 0; i < sz; ++i) {
           uint16_t color_val = transfer_buffer_[i];
 
@@ -208,14 +250,57 @@ void ILI9XXXDisplay::display_() {
 
           this->write_array(pass_buff, sizeof(pass_buff));
         }
-      } else {
-        this->write_array16(transfer_buffer_, sz);
+        pos += sz;
+        rem -= sz;
+      }
+      App.feed_wdt();
+    }
+  } else if (this->buffer_color_mode_ == BITS_16) {
+    // the buffer already holds the pixels in the display format, so they are sent from buffer_ without converting
+    if (w == this->width_) {
+      this->queue_write_array(this->buffer_ + start_pos * 2, w * h * 2);
+    } else {
+      for (uint16_t row = 0; row < h; row++) {
+        this->queue_write_array(this->buffer_ + (start_pos + row * this->width_) * 2, w * 2);
+        App.feed_wdt();
+      }
+    }
+  } else {
+    // convert into one buffer while the other one is sent in the background
+    uint8_t index = 0;
+    uint32_t fill = 0;
+    for (uint16_t row = 0; row < h; row++) {
+      uint32_t pos = start_pos + (row * width_);
+      uint32_t rem = w;
+
+      while (rem > 0) {
+        uint32_t sz = std::min(rem, ILI9XXX_TRANSFER_BUFFER_SIZE);
+        buffer_to_transfer_(pos, sz);
+        if (fill + 2 * sz > sizeof(this->queued_buffer_[0])) {
+          // rows don't always fill the buffer exactly, send it before the chunk would overflow it
+          this->queue_write_array(this->queued_buffer_[index], fill);
+          index ^= 1;
+          fill = 0;
+        }
+        uint8_t *out = this->queued_buffer_[index];
+        for (uint32_t i = 0; i < sz; ++i) {
+          out[fill++] = transfer_buffer_[i] >> 8;
+          out[fill++] = transfer_buffer_[i];
+        }
+        if (fill == sizeof(this->queued_buffer_[0])) {
+          this->queue_write_array(out, fill);
+          index ^= 1;
+          fill = 0;
+        }
+        pos += sz;
+        rem -= sz;
       }
-      pos += sz;
-      rem -= sz;
+      App.feed_wdt();
     }
-    App.feed_wdt();
+    if (fill != 0)
+      this->queue_write_array(this->queued_buffer_[index], fill);
   }
+  this->wait_queued_writes();
   this->end_data_();
 
   // invalidate watermarks
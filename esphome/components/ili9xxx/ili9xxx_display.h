@@ -8,6 +8,8 @@ namespace esphome {
 namespace ili9xxx {
 
 const uint32_t ILI9XXX_TRANSFER_BUFFER_SIZE = 64;
+// pixels per buffer of the double-buffered (queued) transfer
+const uint32_t ILI9XXX_QUEUED_BUFFER_SIZE = ILI9XXX_TRANSFER_BUFFER_SIZE * 4;
 
 enum ILI9XXXColorMode {
   BITS_8 = 0x08,
@@ -50,6 +52,14 @@ class ILI9XXXDisplay : public PollingComponent,
 
  protected:
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) override;
+  /// Convert a color to the pixel format of the buffer.
+  uint16_t convert_color_(Color color) const;
+  /// Store a converted color at the pixel index pos, returns whether the buffer changed.
+  bool set_pixel_(uint32_t pos, uint16_t value);
+  /// Extend the region that is sent on the next update to include [x1,y1] to [x2,y2].
+  void mark_dirty_(int x1, int y1, int x2, int y2);
   void setup_pins_();
   virtual void initialize() = 0;
 
@@ -79,6 +89,8 @@ class ILI9XXXDisplay : public PollingComponent,
   void end_data_();
 
   uint16_t transfer_buffer_[ILI9XXX_TRANSFER_BUFFER_SIZE];
+  // RGB565 big endian pixels, one buffer is filled while the other one is being sent
+  uint8_t queued_buffer_[2][ILI9XXX_QUEUED_BUFFER_SIZE * 2];
 
   uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
 
@@ -6,7 +6,7 @@ import re
 import requests
 
 from esphome import core
-from esphome.components import font
+from esphome.components import display, font
 import esphome.config_validation as cv
 import esphome.codegen as cg
 from esphome.const import (
@@ -41,6 +41,12 @@ IMAGE_TYPE = {
 }
 
 CONF_USE_TRANSPARENCY = "use_transparency"
+CONF_ENCODING = "encoding"
+CONF_RAW_PALETTE_ID = "raw_palette_id"
+
+ENCODING_NONE = "NONE"
+ENCODING_RLE = "RLE"
+ENCODING_PALETTE = "PALETTE"
 
 # If the MDI file cannot be downloaded within this time, abort.
 MDI_DOWNLOAD_TIMEOUT = 30  # seconds
@@ -121,6 +127,12 @@ def validate_cross_dependencies(config):
     if is_mdi and config[CONF_TYPE] not in ["BINARY", "TRANSPARENT_BINARY"]:
         raise cv.Invalid("MDI images must be binary images.")
 
+    if config[CONF_ENCODING] == ENCODING_PALETTE and image_type in [
+        "BINARY",
+        "TRANSPARENT_BINARY",
+    ]:
+        raise cv.Invalid("Binary images can't use palette encoding.")
+
     return config
 
 
@@ -192,7 +204,11 @@ IMAGE_SCHEMA = cv.Schema(
             cv.Optional(CONF_DITHER, default="NONE"): cv.one_of(
                 "NONE", "FLOYDSTEINBERG", upper=True
             ),
+            cv.Optional(CONF_ENCODING, default=ENCODING_NONE): cv.one_of(
+                ENCODING_NONE, ENCODING_RLE, ENCODING_PALETTE, upper=True
+            ),
             cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
+            cv.GenerateID(CONF_RAW_PALETTE_ID): cv.declare_id(cg.uint8),
         },
         validate_cross_dependencies,
     )
@@ -222,6 +238,53 @@ def load_svg_image(file: str, resize: tuple[int, int]):
     return Image.open(io.BytesIO(svg_image))
 
 
+def encode_rle(data, height, unit_size):
+    """Run-length encode each row, preceded by a table of row offsets.
+
+    Returns the encoded data and the size of an offset in bytes.
+    """
+    stride = len(data) // height
+    rows = [
+        display.rle_encode(data[y * stride : (y + 1) * stride], unit_size)
+        for y in range(height)
+    ]
+    offset_size = 2 if sum(len(row) for row in rows) < 0x10000 else 4
+    offsets = []
+    encoded = []
+    for row in rows:
+        offsets += len(encoded).to_bytes(offset_size, "big")
+        encoded += row
+    return offsets + encoded, offset_size
+
+
+def encode_palette(image_id, data, width, height, bytes_per_pixel):
+    """Replace each pixel with an index into a palette of the distinct pixel values.
+
+    Returns the index data, the palette and the size of an index in bits.
+    """
+    pixels = [
+        tuple(data[pos : pos + bytes_per_pixel])
+        for pos in range(0, len(data), bytes_per_pixel)
+    ]
+    colors = sorted(set(pixels))
+    if len(colors) > 256:
+        raise core.EsphomeError(
+            f"Image {image_id} has {len(colors)} colors, palette encoding supports at"
+            " most 256. Please reduce the number of colors or use RLE encoding."
+        )
+    index_bits = next(bits for bits in (1, 2, 4, 8) if len(colors) <= 1 << bits)
+    index_of = {color: index for index, color in enumerate(colors)}
+
+    stride = (width * index_bits + 7) // 8
+    indices = [0] * (stride * height)
+    for pos, pixel in enumerate(pixels):
+        y, x = divmod(pos, width)
+        bit = x * index_bits
+        indices[y * stride + bit // 8] |= index_of[pixel] << (8 - index_bits - bit % 8)
+    palette = [value for color in colors for value in color]
+    return indices, palette, index_bits
+
+
 async def to_code(config):
     from PIL import Image
 
@@ -356,9 +419,39 @@ async def to_code(config):
             f"Image f{config[CONF_ID]} has an unsupported type: {config[CONF_TYPE]}."
         )
 
+    raw_size = len(data)
+    encoding = config[CONF_ENCODING]
+    bytes_per_pixel = {"GRAYSCALE": 1, "RGB565": 2, "RGB24": 3, "RGBA": 4}.get(
+        config[CONF_TYPE], 1
+    )
+    palette = []
+    if encoding == ENCODING_RLE:
+        data, offset_size = encode_rle(data, height, bytes_per_pixel)
+    elif encoding == ENCODING_PALETTE:
+        data, palette, index_bits = encode_palette(
+            config[CONF_ID], data, width, height, bytes_per_pixel
+        )
+    if encoding != ENCODING_NONE:
+        encoded_size = len(data) + len(palette)
+        _LOGGER.info(
+            "Image %s: %s encoding uses %d bytes instead of %d (%d bytes saved)",
+            config[CONF_ID],
+            encoding,
+            encoded_size,
+            raw_size,
+            raw_size - encoded_size,
+        )
+
     rhs = [HexInt(x) for x in data]
     prog_arr = cg.progmem_array(config[CONF_RAW_DATA_ID], rhs)
     var = cg.new_Pvariable(
         config[CONF_ID], prog_arr, width, height, IMAGE_TYPE[config[CONF_TYPE]]
     )
     cg.add(var.set_transparency(transparent))
+    if encoding == ENCODING_RLE:
+        cg.add(var.set_rle_encoding(offset_size))
+    elif encoding == ENCODING_PALETTE:
+        palette_arr = cg.progmem_array(
+            config[CONF_RAW_PALETTE_ID], [HexInt(x) for x in palette]
+        )
+        cg.add(var.set_palette_encoding(palette_arr, index_bits))
@@ -1,98 +1,120 @@
 #include "image.h"
 
+#include <algorithm>
+
+#include "esphome/components/display/rle.h"
 #include "esphome/core/hal.h"
 
 namespace esphome {
 namespace image {
 
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
+  display::BitmapFormat format;
   switch (type_) {
-    case IMAGE_TYPE_BINARY: {
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
-          } else if (!this->transparent_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
-          }
-        }
-      }
+    case IMAGE_TYPE_BINARY:
+      format = display::BITMAP_BINARY;
       break;
-    }
     case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_grayscale_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      format = display::BITMAP_GRAYSCALE;
       break;
     case IMAGE_TYPE_RGB565:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      format = display::BITMAP_RGB565;
       break;
     case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb24_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      format = display::BITMAP_RGB24;
       break;
     case IMAGE_TYPE_RGBA:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgba_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+    default:
+      format = display::BITMAP_RGBA;
       break;
   }
+  if (this->encoding_ == IMAGE_ENCODING_NONE) {
+    display->draw_bitmap(x, y, this->width_, this->height_, this->data_start_, format, color_on, color_off,
+                         this->transparent_);
+    return;
+  }
+
+  // Encoded images are decoded one visible row at a time and drawn from RAM
+  int min_y = std::max(0, -y);
+  int max_y = std::min(this->height_, display->get_height() - y);
+  const display::Rect clipping = display->get_clipping();
+  if (clipping.is_set()) {
+    min_y = std::max(min_y, clipping.y - y);
+    max_y = std::min(max_y, clipping.y2() - y);
+  }
+  for (int row = min_y; row < max_y; row++) {
+    display->draw_bitmap(x, y + row, this->width_, 1, this->get_row_(row), format, color_on, color_off,
+                         this->transparent_);
+  }
+}
+const uint8_t *Image::get_row_(int y) const {
+  if (this->encoding_ == IMAGE_ENCODING_NONE)
+    return this->data_start_ + y * image_type_to_width_stride(this->width_, this->type_);
+  if (y != this->decoded_row_) {
+    // get_pixel() is mostly called for the pixels of a row in turn, those only decode it once
+    this->row_buffer_.resize(image_type_to_width_stride(this->width_, this->type_));
+    this->decode_row_(y, this->row_buffer_.data());
+    this->decoded_row_ = y;
+  }
+  return this->row_buffer_.data();
+}
+void Image::decode_row_(int y, uint8_t *row) const {
+  const int bytes_per_pixel = image_type_to_bpp(this->type_) / 8;
+  if (this->encoding_ == IMAGE_ENCODING_RLE) {
+    uint32_t offset = 0;
+    const uint8_t *entry = this->data_start_ + y * this->offset_size_;
+    for (int i = 0; i < this->offset_size_; i++)
+      offset = (offset << 8) | progmem_read_byte(entry + i);
+    const uint8_t *src = this->data_start_ + this->height_ * this->offset_size_ + offset;
+    if (this->type_ == IMAGE_TYPE_BINARY) {
+      // binary rows are encoded by the byte
+      display::rle_decode(src, row, image_type_to_width_stride(this->width_, this->type_), 1);
+    } else {
+      display::rle_decode(src, row, this->width_, bytes_per_pixel);
+    }
+    return;
+  }
+
+  const uint8_t *indices = this->data_start_ + y * ((this->width_ * this->index_bits_ + 7) / 8);
+  const uint8_t mask = (1 << this->index_bits_) - 1;
+  for (int x = 0; x < this->width_; x++, row += bytes_per_pixel) {
+    const uint32_t bit = x * this->index_bits_;
+    const uint8_t shift = 8 - this->index_bits_ - bit % 8;
+    const uint8_t index = (progmem_read_byte(indices + bit / 8) >> shift) & mask;
+    for (int i = 0; i < bytes_per_pixel; i++)
+      row[i] = progmem_read_byte(this->palette_ + index * bytes_per_pixel + i);
+  }
 }
 Color Image::get_pixel(int x, int y, Color color_on, Color color_off) const {
   if (x < 0 || x >= this->width_ || y < 0 || y >= this->height_)
     return color_off;
+  const uint8_t *row = this->get_row_(y);
   switch (this->type_) {
     case IMAGE_TYPE_BINARY:
-      return this->get_binary_pixel_(x, y) ? color_on : color_off;
+      return this->get_binary_pixel_(row, x) ? color_on : color_off;
     case IMAGE_TYPE_GRAYSCALE:
-      return this->get_grayscale_pixel_(x, y);
+      return this->get_grayscale_pixel_(row, x);
     case IMAGE_TYPE_RGB565:
-      return this->get_rgb565_pixel_(x, y);
+      return this->get_rgb565_pixel_(row, x);
     case IMAGE_TYPE_RGB24:
-      return this->get_rgb24_pixel_(x, y);
+      return this->get_rgb24_pixel_(row, x);
     case IMAGE_TYPE_RGBA:
-      return this->get_rgba_pixel_(x, y);
+      return this->get_rgba_pixel_(row, x);
     default:
       return color_off;
   }
 }
-bool Image::get_binary_pixel_(int x, int y) const {
-  const uint32_t width_8 = ((this->width_ + 7u) / 8u) * 8u;
-  const uint32_t pos = x + y * width_8;
-  return progmem_read_byte(this->data_start_ + (pos / 8u)) & (0x80 >> (pos % 8u));
+bool Image::get_binary_pixel_(const uint8_t *row, int x) const {
+  return progmem_read_byte(row + (x / 8u)) & (0x80 >> (x % 8u));
 }
-Color Image::get_rgba_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * 4;
-  return Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-               progmem_read_byte(this->data_start_ + pos + 2), progmem_read_byte(this->data_start_ + pos + 3));
+Color Image::get_rgba_pixel_(const uint8_t *row, int x) const {
+  const uint8_t *pixel = row + x * 4;
+  return Color(progmem_read_byte(pixel + 0), progmem_read_byte(pixel + 1), progmem_read_byte(pixel + 2),
+               progmem_read_byte(pixel + 3));
 }
-Color Image::get_rgb24_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * 3;
-  Color color = Color(progmem_read_byte(this->data_start_ + pos + 0), progmem_read_byte(this->data_start_ + pos + 1),
-                      progmem_read_byte(this->data_start_ + pos + 2));
+Color Image::get_rgb24_pixel_(const uint8_t *row, int x) const {
+  const uint8_t *pixel = row + x * 3;
+  Color color = Color(progmem_read_byte(pixel + 0), progmem_read_byte(pixel + 1), progmem_read_byte(pixel + 2));
   if (color.b == 1 && color.r == 0 && color.g == 0 && transparent_) {
     // (0, 0, 1) has been defined as transparent color for non-alpha images.
     // putting blue == 1 as a first condition for performance reasons (least likely value to short-cut the if)
@@ -102,10 +124,9 @@ Color Image::get_rgb24_pixel_(int x, int y) const {
   }
   return color;
 }
-Color Image::get_rgb565_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_) * 2;
-  uint16_t rgb565 =
-      progmem_read_byte(this->data_start_ + pos + 0) << 8 | progmem_read_byte(this->data_start_ + pos + 1);
+Color Image::get_rgb565_pixel_(const uint8_t *row, int x) const {
+  const uint8_t *pixel = row + x * 2;
+  uint16_t rgb565 = progmem_read_byte(pixel + 0) << 8 | progmem_read_byte(pixel + 1);
   auto r = (rgb565 & 0xF800) >> 11;
   auto g = (rgb565 & 0x07E0) >> 5;
   auto b = rgb565 & 0x001F;
@@ -118,9 +139,8 @@ Color Image::get_rgb565_pixel_(int x, int y) const {
   }
   return color;
 }
-Color Image::get_grayscale_pixel_(int x, int y) const {
-  const uint32_t pos = (x + y * this->width_);
-  const uint8_t gray = progmem_read_byte(this->data_start_ + pos);
+Color Image::get_grayscale_pixel_(const uint8_t *row, int x) const {
+  const uint8_t gray = progmem_read_byte(row + x);
   uint8_t alpha = (gray == 1 && transparent_) ? 0 : 0xFF;
   return Color(gray, gray, gray, alpha);
 }
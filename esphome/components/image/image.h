@@ -1,4 +1,7 @@
 #pragma once
+
+#include <vector>
+
 #include "esphome/core/color.h"
 #include "esphome/components/display/display_buffer.h"
 
@@ -13,6 +16,15 @@ enum ImageType {
   IMAGE_TYPE_RGBA = 4,
 };
 
+enum ImageEncoding : uint8_t {
+  /// Pixels are stored row by row in the format of the image type.
+  IMAGE_ENCODING_NONE = 0,
+  /// Each row is run-length encoded, the rows are preceded by a table with the offset of every row.
+  IMAGE_ENCODING_RLE = 1,
+  /// Each pixel is an index into a palette of colors in the format of the image type.
+  IMAGE_ENCODING_PALETTE = 2,
+};
+
 inline int image_type_to_bpp(ImageType type) {
   switch (type) {
     case IMAGE_TYPE_BINARY:
@@ -44,18 +56,44 @@ class Image : public display::BaseImage {
   void set_transparency(bool transparent) { transparent_ = transparent; }
   bool has_transparency() const { return transparent_; }
 
+  /// The data is run-length encoded, each row offset takes offset_size bytes.
+  void set_rle_encoding(uint8_t offset_size) {
+    this->encoding_ = IMAGE_ENCODING_RLE;
+    this->offset_size_ = offset_size;
+  }
+  /// The data holds palette indices of index_bits bits, the palette holds colors in the format of the image type.
+  void set_palette_encoding(const uint8_t *palette, uint8_t index_bits) {
+    this->encoding_ = IMAGE_ENCODING_PALETTE;
+    this->palette_ = palette;
+    this->index_bits_ = index_bits;
+  }
+  ImageEncoding get_encoding() const { return this->encoding_; }
+
  protected:
-  bool get_binary_pixel_(int x, int y) const;
-  Color get_rgb24_pixel_(int x, int y) const;
-  Color get_rgba_pixel_(int x, int y) const;
-  Color get_rgb565_pixel_(int x, int y) const;
-  Color get_grayscale_pixel_(int x, int y) const;
+  /// Decode a row of an encoded image into the format of the image type.
+  void decode_row_(int y, uint8_t *row) const;
+  /// The row in the format of the image type, encoded images decode it into row_buffer_.
+  const uint8_t *get_row_(int y) const;
+
+  bool get_binary_pixel_(const uint8_t *row, int x) const;
+  Color get_rgb24_pixel_(const uint8_t *row, int x) const;
+  Color get_rgba_pixel_(const uint8_t *row, int x) const;
+  Color get_rgb565_pixel_(const uint8_t *row, int x) const;
+  Color get_grayscale_pixel_(const uint8_t *row, int x) const;
 
   int width_;
   int height_;
   ImageType type_;
   const uint8_t *data_start_;
   bool transparent_;
+
+  ImageEncoding encoding_{IMAGE_ENCODING_NONE};
+  uint8_t offset_size_{0};
+  const uint8_t *palette_{nullptr};
+  uint8_t index_bits_{0};
+  /// the last decoded row of an encoded image, allocated when the first row is decoded
+  mutable std::vector<uint8_t> row_buffer_;
+  mutable int decoded_row_{-1};
 };
 
 }  // namespace image
@@ -62,6 +62,16 @@ std::string build_json(const json_build_t &f) {
   }
 }
 
+std::string write_json(const json_write_t &f) {
+  std::string output;
+  output.reserve(128);
+  JsonWriter writer(output);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+  return output;
+}
+
 void parse_json(const std::string &data, const json_parse_t &f) {
   // Here we are allocating 1.5 times the data size,
   // with the heap size minus 2kb to be safe if less than that
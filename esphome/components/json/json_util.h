@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "esphome/core/helpers.h"
+#include "json_writer.h"
 
 #define ARDUINOJSON_ENABLE_STD_STRING 1  // NOLINT
 
@@ -22,6 +23,12 @@ using json_build_t = std::function<void(JsonObject)>;
 /// Build a JSON string with the provided json build function.
 std::string build_json(const json_build_t &f);
 
+/// Callback function typedef for writing a JSON object with a JsonWriter.
+using json_write_t = std::function<void(JsonWriter &)>;
+
+/// Write a JSON object with the provided json write function, serializing directly into the returned string.
+std::string write_json(const json_write_t &f);
+
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
 
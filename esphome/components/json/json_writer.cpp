@@ -0,0 +1,158 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace json {
+
+void JsonWriter::begin_object() {
+  this->separate_();
+  this->output_ += '{';
+  this->need_comma_ = false;
+}
+void JsonWriter::begin_object(const char *key) {
+  this->key(key);
+  this->begin_object();
+}
+void JsonWriter::end_object() {
+  this->output_ += '}';
+  this->need_comma_ = true;
+}
+void JsonWriter::begin_array() {
+  this->separate_();
+  this->output_ += '[';
+  this->need_comma_ = false;
+}
+void JsonWriter::begin_array(const char *key) {
+  this->key(key);
+  this->begin_array();
+}
+void JsonWriter::end_array() {
+  this->output_ += ']';
+  this->need_comma_ = true;
+}
+
+void JsonWriter::key(const char *key) {
+  this->write_string_(key, strlen(key));
+  this->output_ += ':';
+  // the value follows without a separator
+  this->need_comma_ = false;
+}
+
+void JsonWriter::value(const char *value) {
+  if (value == nullptr) {
+    this->null();
+    return;
+  }
+  this->write_string_(value, strlen(value));
+}
+void JsonWriter::value(bool value) {
+  this->separate_();
+  this->output_ += value ? "true" : "false";
+  this->need_comma_ = true;
+}
+void JsonWriter::value(double value) {
+  if (!std::isfinite(value)) {
+    this->null();
+    return;
+  }
+  this->separate_();
+  // the values written are floats, more digits would only show rounding noise
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%.7g", value);
+  this->output_ += buf;
+  this->need_comma_ = true;
+}
+void JsonWriter::null() {
+  this->separate_();
+  this->output_ += "null";
+  this->need_comma_ = true;
+}
+
+void JsonWriter::merge_object(const std::string &object) {
+  size_t begin = object.find('{');
+  size_t end = object.rfind('}');
+  if (begin == std::string::npos || end == std::string::npos || end <= begin + 1)
+    return;
+  this->separate_();
+  this->output_.append(object, begin + 1, end - begin - 1);
+  this->need_comma_ = true;
+}
+
+void JsonWriter::separate_() {
+  if (this->need_comma_)
+    this->output_ += ',';
+}
+
+void JsonWriter::write_string_(const char *data, size_t len) {
+  static const char *const HEX_CHARS = "0123456789abcdef";
+  this->separate_();
+  this->output_ += '"';
+  const char *run = data;
+  for (const char *c = data; c != data + len; c++) {
+    auto ch = static_cast<uint8_t>(*c);
+    if (ch >= 0x20 && ch != '"' && ch != '\\')
+      continue;
+    // copy the characters that don't need escaping in one go
+    this->output_.append(run, c - run);
+    run = c + 1;
+    this->output_ += '\\';
+    switch (ch) {
+      case '"':
+      case '\\':
+        this->output_ += static_cast<char>(ch);
+        break;
+      case '\b':
+        this->output_ += 'b';
+        break;
+      case '\f':
+        this->output_ += 'f';
+        break;
+      case '\n':
+        this->output_ += 'n';
+        break;
+      case '\r':
+        this->output_ += 'r';
+        break;
+      case '\t':
+        this->output_ += 't';
+        break;
+      default:
+        this->output_ += "u00";
+        this->output_ += HEX_CHARS[ch >> 4];
+        this->output_ += HEX_CHARS[ch & 0x0F];
+        break;
+    }
+  }
+  this->output_.append(run, data + len - run);
+  this->output_ += '"';
+  this->need_comma_ = true;
+}
+
+void JsonWriter::write_int_(int64_t value) {
+  if (value >= 0) {
+    this->write_uint_(static_cast<uint64_t>(value));
+    return;
+  }
+  this->separate_();
+  this->output_ += '-';
+  this->need_comma_ = false;
+  this->write_uint_(0 - static_cast<uint64_t>(value));
+}
+void JsonWriter::write_uint_(uint64_t value) {
+  // not every platform's printf supports 64 bit integers
+  char buf[20];
+  char *pos = buf + sizeof(buf);
+  do {
+    *--pos = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  this->separate_();
+  this->output_.append(pos, buf + sizeof(buf) - pos);
+  this->need_comma_ = true;
+}
+
+}  // namespace json
+}  // namespace esphome
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace esphome {
+namespace json {
+
+/** Streaming JSON writer.
+ *
+ * Serializes values directly into the output string in a single pass, without building a document in memory first.
+ * The caller is responsible for the structure: keys are only valid inside objects, and every begin_*() call must be
+ * matched by the corresponding end_*() call.
+ *
+ * Floating point values that are not finite are written as null.
+ */
+class JsonWriter {
+ public:
+  explicit JsonWriter(std::string &output) : output_(output) {}
+
+  void begin_object();
+  void begin_object(const char *key);
+  void end_object();
+  void begin_array();
+  void begin_array(const char *key);
+  void end_array();
+
+  void key(const char *key);
+
+  void value(const char *value);
+  void value(const std::string &value) { this->write_string_(value.data(), value.size()); }
+  void value(bool value);
+  void value(double value);
+  template<typename T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, int>::type = 0>
+  void value(T value) {
+    if (std::is_signed<T>::value) {
+      this->write_int_(static_cast<int64_t>(value));
+    } else {
+      this->write_uint_(static_cast<uint64_t>(value));
+    }
+  }
+  void null();
+
+  /// Write a key/value pair.
+  template<typename T> void add(const char *key, T &&value) {
+    this->key(key);
+    this->value(std::forward<T>(value));
+  }
+
+  /// Copy the members of an already serialized JSON object into the current object.
+  void merge_object(const std::string &object);
+
+ protected:
+  void separate_();
+  void write_string_(const char *data, size_t len);
+  void write_int_(int64_t value);
+  void write_uint_(uint64_t value);
+
+  std::string &output_;
+  /// whether the next member or element needs a separating comma
+  bool need_comma_{false};
+};
+
+}  // namespace json
+}  // namespace esphome
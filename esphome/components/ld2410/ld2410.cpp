@@ -111,8 +111,11 @@ void LD2410Component::loop() {
   const int max_line_length = 80;
   static uint8_t buffer[max_line_length];
 
-  while (available()) {
-    this->readline_(read(), buffer, max_line_length);
+  uint8_t data[64];
+  size_t len;
+  while ((len = this->read_available(data, sizeof(data))) > 0) {
+    for (size_t i = 0; i < len; i++)
+      this->readline_(data[i], buffer, max_line_length);
   }
 }
 
@@ -44,6 +44,11 @@ inline ledc_mode_t get_speed_mode(uint8_t) { return LEDC_LOW_SPEED_MODE; }
 #endif
 #endif
 
+#if defined(USE_ESP_IDF) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+static bool ledc_fade_installed = false;       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static bool ledc_fade_install_failed = false;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+#endif
+
 float ledc_max_frequency_for_bit_depth(uint8_t bit_depth) { return CLOCK_FREQUENCY / float(1 << bit_depth); }
 
 float ledc_min_frequency_for_bit_depth(uint8_t bit_depth, bool low_frequency) {
@@ -96,19 +101,23 @@ esp_err_t configure_timer_frequency(ledc_mode_t speed_mode, ledc_timer_t timer_n
 }
 #endif
 
-void LEDCOutput::write_state(float state) {
-  if (!initialized_) {
-    ESP_LOGW(TAG, "LEDC output hasn't been initialized yet!");
-    return;
-  }
-
+uint32_t LEDCOutput::duty_for_state_(float state) {
   if (this->pin_->is_inverted())
     state = 1.0f - state;
 
   this->duty_ = state;
   const uint32_t max_duty = (uint32_t(1) << this->bit_depth_) - 1;
   const float duty_rounded = roundf(state * max_duty);
-  auto duty = static_cast<uint32_t>(duty_rounded);
+  return static_cast<uint32_t>(duty_rounded);
+}
+
+void LEDCOutput::write_state(float state) {
+  if (!initialized_) {
+    ESP_LOGW(TAG, "LEDC output hasn't been initialized yet!");
+    return;
+  }
+
+  auto duty = this->duty_for_state_(state);
 
 #ifdef USE_ARDUINO
   ESP_LOGV(TAG, "Setting duty: %u on channel %u", duty, this->channel_);
@@ -117,11 +126,50 @@ void LEDCOutput::write_state(float state) {
 #ifdef USE_ESP_IDF
   auto speed_mode = get_speed_mode(channel_);
   auto chan_num = static_cast<ledc_channel_t>(channel_ % 8);
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  this->stop_fade_();
+#endif
   ledc_set_duty(speed_mode, chan_num, duty);
   ledc_update_duty(speed_mode, chan_num);
 #endif
 }
 
+#if defined(USE_ESP_IDF) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+void LEDCOutput::write_state_fade(float state, uint32_t length) {
+  if (!initialized_) {
+    ESP_LOGW(TAG, "LEDC output hasn't been initialized yet!");
+    return;
+  }
+  if (!ledc_fade_installed && !ledc_fade_install_failed) {
+    // The fade service is shared by all channels, it is only installed once an output fades
+    ledc_fade_installed = ledc_fade_func_install(0) == ESP_OK;
+    ledc_fade_install_failed = !ledc_fade_installed;
+    if (ledc_fade_install_failed)
+      ESP_LOGW(TAG, "Installing the LEDC fade service failed, fading in software");
+  }
+
+  auto duty = this->duty_for_state_(state);
+  ESP_LOGVV(TAG, "Fading to duty: %u over %u ms on channel %u", duty, length, this->channel_);
+  auto speed_mode = get_speed_mode(channel_);
+  auto chan_num = static_cast<ledc_channel_t>(channel_ % 8);
+  // A fade that is superseded is stopped, waiting for it would block the main loop
+  this->stop_fade_();
+  if (ledc_fade_installed && ledc_set_fade_with_time(speed_mode, chan_num, duty, length) == ESP_OK &&
+      ledc_fade_start(speed_mode, chan_num, LEDC_FADE_NO_WAIT) == ESP_OK) {
+    this->fading_ = true;
+  } else {
+    this->write_state(state);
+  }
+}
+
+void LEDCOutput::stop_fade_() {
+  if (!this->fading_)
+    return;
+  this->fading_ = false;
+  ledc_fade_stop(get_speed_mode(channel_), static_cast<ledc_channel_t>(channel_ % 8));
+}
+#endif
+
 void LEDCOutput::setup() {
   ESP_LOGV(TAG, "Entering setup...");
 #ifdef USE_ARDUINO
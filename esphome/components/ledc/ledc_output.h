@@ -7,6 +7,10 @@
 
 #ifdef USE_ESP32
 
+#ifdef USE_ESP_IDF
+#include <esp_idf_version.h>
+#endif
+
 namespace esphome {
 namespace ledc {
 
@@ -31,7 +35,24 @@ class LEDCOutput : public output::FloatOutput, public Component {
   /// Override FloatOutput's write_state.
   void write_state(float state) override;
 
+#if defined(USE_ESP_IDF) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  /// The LEDC fade hardware ramps the duty cycle on its own. Older ESP-IDF versions can't stop a fade early, any
+  /// write would block until the fade ends, so fades are only used from ESP-IDF 5.0 on.
+  bool supports_fade() const override { return true; }
+  /// Override FloatOutput's write_state_fade.
+  void write_state_fade(float state, uint32_t length) override;
+#endif
+
  protected:
+  /// Convert state to a duty cycle for the current bit depth, applying the pin inversion.
+  uint32_t duty_for_state_(float state);
+#if defined(USE_ESP_IDF) && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  /// Stop the fade started on this channel, if any, so the duty can be changed without waiting for it.
+  void stop_fade_();
+
+  bool fading_{false};
+#endif
+
   InternalGPIOPin *pin_;
   uint8_t channel_{};
   uint8_t bit_depth_{};
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <cinttypes>
 #include <utility>
 #include <vector>
 
 #include "esphome/core/component.h"
+#include "esphome/core/log.h"
 #include "esphome/components/light/light_state.h"
 #include "esphome/components/light/addressable_light.h"
 
@@ -353,5 +356,145 @@ class AddressableFlickerEffect : public AddressableLightEffect {
   uint8_t intensity_{13};
 };
 
+/// How the colors of a shader layer are combined with the layers below it.
+enum ShaderBlendMode : uint8_t {
+  SHADER_BLEND_REPLACE,
+  SHADER_BLEND_ADD,
+  SHADER_BLEND_SUBTRACT,
+  SHADER_BLEND_MULTIPLY,
+  SHADER_BLEND_LIGHTEN,
+};
+
+/// One layer of an AddressableShaderEffect.
+class AddressableShaderLayer {
+ public:
+  virtual ~AddressableShaderLayer() = default;
+  /// Blend the colors of this layer for all size pixels into canvas.
+  virtual void render(Color *canvas, int32_t size, uint32_t time, const Color &current_color) = 0;
+
+  void set_blend_mode(ShaderBlendMode blend_mode) { this->blend_mode_ = blend_mode; }
+  /// Time in µs it took to render this layer for the last frame.
+  uint32_t get_render_time() const { return this->render_time_; }
+
+ protected:
+  friend class AddressableShaderEffect;
+
+  ShaderBlendMode blend_mode_{SHADER_BLEND_REPLACE};
+  uint32_t render_time_{0};
+};
+
+/** A shader layer computing the color of every pixel with a function of its index and the effect time.
+ *
+ * The function type is a template parameter, so the function is inlined into the loop over all pixels. There is one
+ * loop per blend mode, so no per-pixel dispatch is left besides the function itself.
+ */
+template<typename F> class AddressableShaderLayerImpl : public AddressableShaderLayer {
+ public:
+  explicit AddressableShaderLayerImpl(F f) : f_(std::move(f)) {}
+
+  void render(Color *canvas, int32_t size, uint32_t time, const Color &current_color) override {
+    switch (this->blend_mode_) {
+      case SHADER_BLEND_REPLACE:
+        this->render_(canvas, size, time, current_color, [](Color dst, Color src) { return src; });
+        break;
+      case SHADER_BLEND_ADD:
+        this->render_(canvas, size, time, current_color, [](Color dst, Color src) { return dst + src; });
+        break;
+      case SHADER_BLEND_SUBTRACT:
+        this->render_(canvas, size, time, current_color, [](Color dst, Color src) { return dst - src; });
+        break;
+      case SHADER_BLEND_MULTIPLY:
+        this->render_(canvas, size, time, current_color, [](Color dst, Color src) { return dst * src; });
+        break;
+      case SHADER_BLEND_LIGHTEN:
+        this->render_(canvas, size, time, current_color, [](Color dst, Color src) {
+          return Color(std::max(dst.r, src.r), std::max(dst.g, src.g), std::max(dst.b, src.b),
+                       std::max(dst.w, src.w));
+        });
+        break;
+    }
+  }
+
+ protected:
+  template<typename B> void render_(Color *canvas, int32_t size, uint32_t time, Color current_color, B blend) {
+    for (int32_t i = 0; i < size; i++)
+      canvas[i] = blend(canvas[i], this->f_(i, size, time, current_color));
+  }
+
+  F f_;
+};
+
+/// Create a shader layer for the given function, called as Color f(int32_t index, int32_t size, uint32_t time,
+/// Color current_color).
+template<typename F> AddressableShaderLayer *make_shader_layer(F f) {
+  return new AddressableShaderLayerImpl<F>(std::move(f));  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+/** Effect rendering a stack of shader layers.
+ *
+ * The layers are rendered into a canvas holding one color per pixel, which is then copied to the light once per frame.
+ * The time passed to the layers is the number of milliseconds since the effect was started.
+ */
+class AddressableShaderEffect : public AddressableLightEffect {
+ public:
+  explicit AddressableShaderEffect(const std::string &name) : AddressableLightEffect(name) {}
+  void start() override {
+    this->start_time_ = millis();
+    this->max_frame_time_ = 0;
+  }
+  void stop() override {
+    AddressableLightEffect::stop();
+    // free the canvas while the effect isn't running
+    std::vector<Color>().swap(this->canvas_);
+  }
+  void apply(AddressableLight &it, const Color &current_color) override {
+    const uint32_t now = millis();
+    if (now - this->last_update_ < this->update_interval_)
+      return;
+    this->last_update_ = now;
+
+    const uint32_t frame_start = micros();
+    const int32_t size = it.size();
+    // every frame starts from black, so the result only depends on the index and the time
+    this->canvas_.assign(size, Color::BLACK);
+    const uint32_t time = now - this->start_time_;
+    for (auto *layer : this->layers_) {
+      const uint32_t layer_start = micros();
+      layer->render(this->canvas_.data(), size, time, current_color);
+      layer->render_time_ = micros() - layer_start;
+    }
+
+    const Color *color = this->canvas_.data();
+    for (auto view : it)
+      view = *color++;
+    it.schedule_show();
+
+    this->frame_time_ = micros() - frame_start;
+    this->max_frame_time_ = std::max(this->max_frame_time_, this->frame_time_);
+    esph_log_vv("light.shader", "'%s' frame rendered in %" PRIu32 " us (max %" PRIu32 " us)", this->name_.c_str(),
+                this->frame_time_, this->max_frame_time_);
+  }
+
+  void add_layer(AddressableShaderLayer *layer, ShaderBlendMode blend_mode) {
+    layer->set_blend_mode(blend_mode);
+    this->layers_.push_back(layer);
+  }
+  void set_update_interval(uint32_t update_interval) { this->update_interval_ = update_interval; }
+
+  const std::vector<AddressableShaderLayer *> &get_layers() const { return this->layers_; }
+  /// Time in µs it took to render and copy the last frame.
+  uint32_t get_frame_time() const { return this->frame_time_; }
+  uint32_t get_max_frame_time() const { return this->max_frame_time_; }
+
+ protected:
+  std::vector<AddressableShaderLayer *> layers_;
+  std::vector<Color> canvas_;
+  uint32_t update_interval_{16};
+  uint32_t last_update_{0};
+  uint32_t start_time_{0};
+  uint32_t frame_time_{0};
+  uint32_t max_frame_time_{0};
+};
+
 }  // namespace light
 }  // namespace esphome
@@ -52,8 +52,11 @@ from .types import (
     AddressableRandomTwinkleEffect,
     AddressableFireworksEffect,
     AddressableFlickerEffect,
+    AddressableShaderEffect,
     AutomationLightEffect,
     Color,
+    ShaderBlendMode,
+    make_shader_layer,
 )
 
 CONF_ADD_LED_INTERVAL = "add_led_interval"
@@ -75,6 +78,9 @@ CONF_ADDRESSABLE_TWINKLE = "addressable_twinkle"
 CONF_ADDRESSABLE_RANDOM_TWINKLE = "addressable_random_twinkle"
 CONF_ADDRESSABLE_FIREWORKS = "addressable_fireworks"
 CONF_ADDRESSABLE_FLICKER = "addressable_flicker"
+CONF_ADDRESSABLE_SHADER = "addressable_shader"
+CONF_LAYERS = "layers"
+CONF_BLEND = "blend"
 CONF_AUTOMATION = "automation"
 CONF_ON_LENGTH = "on_length"
 CONF_OFF_LENGTH = "off_length"
@@ -509,6 +515,52 @@ async def addressable_flicker_effect_to_code(config, effect_id):
     return var
 
 
+SHADER_BLEND_MODES = {
+    "REPLACE": ShaderBlendMode.SHADER_BLEND_REPLACE,
+    "ADD": ShaderBlendMode.SHADER_BLEND_ADD,
+    "SUBTRACT": ShaderBlendMode.SHADER_BLEND_SUBTRACT,
+    "MULTIPLY": ShaderBlendMode.SHADER_BLEND_MULTIPLY,
+    "LIGHTEN": ShaderBlendMode.SHADER_BLEND_LIGHTEN,
+}
+
+SHADER_LAYER_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_LAMBDA): cv.returning_lambda,
+        cv.Optional(CONF_BLEND, default="REPLACE"): cv.enum(
+            SHADER_BLEND_MODES, upper=True
+        ),
+    }
+)
+
+
+@register_addressable_effect(
+    "addressable_shader",
+    AddressableShaderEffect,
+    "Shader",
+    {
+        cv.Required(CONF_LAYERS): cv.All(
+            cv.ensure_list(SHADER_LAYER_SCHEMA), cv.Length(min=1)
+        ),
+        cv.Optional(
+            CONF_UPDATE_INTERVAL, default="16ms"
+        ): cv.positive_time_period_milliseconds,
+    },
+)
+async def addressable_shader_effect_to_code(config, effect_id):
+    var = cg.new_Pvariable(effect_id, config[CONF_NAME])
+    cg.add(var.set_update_interval(config[CONF_UPDATE_INTERVAL]))
+    args = [
+        (cg.int32, "index"),
+        (cg.int32, "size"),
+        (cg.uint32, "time"),
+        (Color, "current_color"),
+    ]
+    for layer in config[CONF_LAYERS]:
+        lambda_ = await cg.process_lambda(layer[CONF_LAMBDA], args, return_type=Color)
+        cg.add(var.add_layer(make_shader_layer(lambda_), layer[CONF_BLEND]))
+    return var
+
+
 def validate_effects(allowed_effects):
     @schema_extractor("effects")
     def validator(value):
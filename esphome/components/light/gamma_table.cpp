@@ -0,0 +1,30 @@
+#include "gamma_table.h"
+
+#include <cmath>
+
+namespace esphome {
+namespace light {
+
+static GammaTable *gamma_tables = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+const GammaTable *GammaTable::get(float gamma) {
+  if (gamma <= 0.0f)
+    return nullptr;
+  // Nearly all lights share a single gamma value, so the list stays very short
+  for (GammaTable *table = gamma_tables; table != nullptr; table = table->next_) {
+    if (table->gamma_ == gamma)
+      return table;
+  }
+  auto *table = new GammaTable(gamma);  // NOLINT(cppcoreguidelines-owning-memory)
+  table->next_ = gamma_tables;
+  gamma_tables = table;
+  return table;
+}
+
+GammaTable::GammaTable(float gamma) : gamma_(gamma) {
+  for (int i = 0; i <= GAMMA_TABLE_SIZE; i++)
+    this->table_[i] = powf(float(i) / GAMMA_TABLE_SIZE, gamma);
+}
+
+}  // namespace light
+}  // namespace esphome
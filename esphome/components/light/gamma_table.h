@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace light {
+
+/// Number of segments of a gamma table, the table holds one more entry for the end of the last segment.
+static const int GAMMA_TABLE_SIZE = 256;
+
+/** Gamma correction through a lookup table.
+ *
+ * powf() is expensive, especially on chips without a floating point unit, and used to run for every channel of every
+ * light on every loop during transitions. A table holds the corrected values of evenly spaced inputs, values in between
+ * are linearly interpolated. Tables are created on first use and shared by all lights with the same gamma.
+ */
+class GammaTable {
+ public:
+  /// Get the table for gamma, or nullptr when gamma doesn't apply any correction.
+  static const GammaTable *get(float gamma);
+
+  /// Gamma correct value, which is in the range 0.0 to 1.0.
+  float correct(float value) const {
+    if (value <= 0.0f)
+      return 0.0f;
+    if (value >= 1.0f)
+      return 1.0f;
+    const float position = value * GAMMA_TABLE_SIZE;
+    const int index = static_cast<int>(position);
+    const float low = this->table_[index];
+    return low + (this->table_[index + 1] - low) * (position - index);
+  }
+
+ protected:
+  explicit GammaTable(float gamma);
+
+  float gamma_;
+  float table_[GAMMA_TABLE_SIZE + 1];
+  /// The next table in the list of all tables
+  GammaTable *next_{nullptr};
+};
+
+/// Gamma correct value like gamma_correct(), using the shared table for gamma.
+inline float gamma_correct_table(float value, float gamma) {
+  const GammaTable *table = GammaTable::get(gamma);
+  if (table == nullptr)
+    return value <= 0.0f ? 0.0f : value;
+  return table->correct(value);
+}
+
+}  // namespace light
+}  // namespace esphome
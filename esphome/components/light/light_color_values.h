@@ -2,6 +2,7 @@
 
 #include "esphome/core/helpers.h"
 #include "color_mode.h"
+#include "gamma_table.h"
 #include <cmath>
 
 namespace esphome {
@@ -131,16 +132,16 @@ class LightColorValues {
 
   /// Convert these light color values to a brightness-only representation and write them to brightness.
   void as_brightness(float *brightness, float gamma = 0) const {
-    *brightness = gamma_correct(this->state_ * this->brightness_, gamma);
+    *brightness = gamma_correct_table(this->state_ * this->brightness_, gamma);
   }
 
   /// Convert these light color values to an RGB representation and write them to red, green, blue.
   void as_rgb(float *red, float *green, float *blue, float gamma = 0, bool color_interlock = false) const {
     if (this->color_mode_ & ColorCapability::RGB) {
       float brightness = this->state_ * this->brightness_ * this->color_brightness_;
-      *red = gamma_correct(brightness * this->red_, gamma);
-      *green = gamma_correct(brightness * this->green_, gamma);
-      *blue = gamma_correct(brightness * this->blue_, gamma);
+      *red = gamma_correct_table(brightness * this->red_, gamma);
+      *green = gamma_correct_table(brightness * this->green_, gamma);
+      *blue = gamma_correct_table(brightness * this->blue_, gamma);
     } else {
       *red = *green = *blue = 0;
     }
@@ -151,7 +152,7 @@ class LightColorValues {
                bool color_interlock = false) const {
     this->as_rgb(red, green, blue, gamma);
     if (this->color_mode_ & ColorCapability::WHITE) {
-      *white = gamma_correct(this->state_ * this->brightness_ * this->white_, gamma);
+      *white = gamma_correct_table(this->state_ * this->brightness_ * this->white_, gamma);
     } else {
       *white = 0;
     }
@@ -174,9 +175,9 @@ class LightColorValues {
   /// Convert these light color values to an CWWW representation with the given parameters.
   void as_cwww(float *cold_white, float *warm_white, float gamma = 0, bool constant_brightness = false) const {
     if (this->color_mode_ & ColorCapability::COLD_WARM_WHITE) {
-      const float cw_level = gamma_correct(this->cold_white_, gamma);
-      const float ww_level = gamma_correct(this->warm_white_, gamma);
-      const float white_level = gamma_correct(this->state_ * this->brightness_, gamma);
+      const float cw_level = gamma_correct_table(this->cold_white_, gamma);
+      const float ww_level = gamma_correct_table(this->warm_white_, gamma);
+      const float white_level = gamma_correct_table(this->state_ * this->brightness_, gamma);
       if (!constant_brightness) {
         *cold_white = white_level * cw_level;
         *warm_white = white_level * ww_level;
@@ -202,7 +203,7 @@ class LightColorValues {
     if (this->color_mode_ & ColorCapability::COLOR_TEMPERATURE) {
       *color_temperature =
           (this->color_temperature_ - color_temperature_cw) / (color_temperature_ww - color_temperature_cw);
-      *white_brightness = gamma_correct(this->state_ * this->brightness_ * white_level, gamma);
+      *white_brightness = gamma_correct_table(this->state_ * this->brightness_ * white_level, gamma);
     } else {  // Probably won't get here but put this here anyway.
       *white_brightness = 0;
     }
@@ -1,6 +1,8 @@
 #include "light_json_schema.h"
 #include "light_output.h"
 
+#include <utility>
+
 #ifdef USE_JSON
 
 namespace esphome {
@@ -8,70 +10,95 @@ namespace light {
 
 // See https://www.home-assistant.io/integrations/light.mqtt/#json-schema for documentation on the schema
 
-void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
+/// Gives a JsonObject the key/value interface of a JsonWriter, so both are filled by the same code.
+class JsonObjectSink {
+ public:
+  explicit JsonObjectSink(JsonObject root) : root_(root), current_(root) {}
+
+  template<typename T> void add(const char *key, T &&value) { this->current_[key] = std::forward<T>(value); }
+  void begin_object(const char *key) { this->current_ = this->root_.createNestedObject(key); }
+  void end_object() { this->current_ = this->root_; }
+
+ protected:
+  JsonObject root_;
+  JsonObject current_;
+};
+
+/// Write the state of a light to either sink, a JsonWriter or a JsonObjectSink.
+template<typename Sink> static void dump_json_to(LightState &state, Sink &root) {
   if (state.supports_effects())
-    root["effect"] = state.get_effect_name();
+    root.add("effect", state.get_effect_name());
 
   auto values = state.remote_values;
-  auto traits = state.get_output()->get_traits();
-
+  const char *color_mode = nullptr;
   switch (values.get_color_mode()) {
     case ColorMode::UNKNOWN:  // don't need to set color mode if we don't know it
       break;
     case ColorMode::ON_OFF:
-      root["color_mode"] = "onoff";
+      color_mode = "onoff";
       break;
     case ColorMode::BRIGHTNESS:
-      root["color_mode"] = "brightness";
+      color_mode = "brightness";
       break;
     case ColorMode::WHITE:  // not supported by HA in MQTT
-      root["color_mode"] = "white";
+      color_mode = "white";
       break;
     case ColorMode::COLOR_TEMPERATURE:
-      root["color_mode"] = "color_temp";
+      color_mode = "color_temp";
       break;
     case ColorMode::COLD_WARM_WHITE:  // not supported by HA
-      root["color_mode"] = "cwww";
+      color_mode = "cwww";
       break;
     case ColorMode::RGB:
-      root["color_mode"] = "rgb";
+      color_mode = "rgb";
       break;
     case ColorMode::RGB_WHITE:
-      root["color_mode"] = "rgbw";
+      color_mode = "rgbw";
       break;
     case ColorMode::RGB_COLOR_TEMPERATURE:  // not supported by HA
-      root["color_mode"] = "rgbct";
+      color_mode = "rgbct";
       break;
     case ColorMode::RGB_COLD_WARM_WHITE:
-      root["color_mode"] = "rgbww";
+      color_mode = "rgbww";
       break;
   }
+  if (color_mode != nullptr)
+    root.add("color_mode", color_mode);
 
   if (values.get_color_mode() & ColorCapability::ON_OFF)
-    root["state"] = (values.get_state() != 0.0f) ? "ON" : "OFF";
+    root.add("state", (values.get_state() != 0.0f) ? "ON" : "OFF");
   if (values.get_color_mode() & ColorCapability::BRIGHTNESS)
-    root["brightness"] = uint8_t(values.get_brightness() * 255);
+    root.add("brightness", uint8_t(values.get_brightness() * 255));
 
-  JsonObject color = root.createNestedObject("color");
+  root.begin_object("color");
   if (values.get_color_mode() & ColorCapability::RGB) {
-    color["r"] = uint8_t(values.get_color_brightness() * values.get_red() * 255);
-    color["g"] = uint8_t(values.get_color_brightness() * values.get_green() * 255);
-    color["b"] = uint8_t(values.get_color_brightness() * values.get_blue() * 255);
+    root.add("r", uint8_t(values.get_color_brightness() * values.get_red() * 255));
+    root.add("g", uint8_t(values.get_color_brightness() * values.get_green() * 255));
+    root.add("b", uint8_t(values.get_color_brightness() * values.get_blue() * 255));
   }
-  if (values.get_color_mode() & ColorCapability::WHITE) {
-    color["w"] = uint8_t(values.get_white() * 255);
-    root["white_value"] = uint8_t(values.get_white() * 255);  // legacy API
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    root.add("w", uint8_t(values.get_white() * 255));
+  if (values.get_color_mode() & ColorCapability::COLD_WARM_WHITE) {
+    root.add("c", uint8_t(values.get_cold_white() * 255));
+    root.add("w", uint8_t(values.get_warm_white() * 255));
   }
+  root.end_object();
+
+  if (values.get_color_mode() & ColorCapability::WHITE)
+    root.add("white_value", uint8_t(values.get_white() * 255));  // legacy API
   if (values.get_color_mode() & ColorCapability::COLOR_TEMPERATURE) {
     // this one isn't under the color subkey for some reason
-    root["color_temp"] = uint32_t(values.get_color_temperature());
-  }
-  if (values.get_color_mode() & ColorCapability::COLD_WARM_WHITE) {
-    color["c"] = uint8_t(values.get_cold_white() * 255);
-    color["w"] = uint8_t(values.get_warm_white() * 255);
+    root.add("color_temp", uint32_t(values.get_color_temperature()));
   }
 }
 
+void LightJSONSchema::dump_json(LightState &state, JsonObject root) {
+  JsonObjectSink sink(root);
+  dump_json_to(state, sink);
+}
+
+void LightJSONSchema::dump_json(LightState &state, json::JsonWriter &root) { dump_json_to(state, root); }
+
 void LightJSONSchema::parse_color_json(LightState &state, LightCall &call, JsonObject root) {
   if (root.containsKey("state")) {
     auto val = parse_on_off(root["state"]);
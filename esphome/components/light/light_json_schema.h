@@ -15,6 +15,8 @@ class LightJSONSchema {
  public:
   /// Dump the state of a light as JSON.
   static void dump_json(LightState &state, JsonObject root);
+  /// Dump the state of a light into an object that is being written.
+  static void dump_json(LightState &state, json::JsonWriter &root);
   /// Parse the JSON state of a light to a LightCall.
   static void parse_json(LightState &state, LightCall &call, JsonObject root);
 
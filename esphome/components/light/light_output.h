@@ -27,6 +27,13 @@ class LightOutput {
   /// should write the new state to hardware. Every call to write_state() is
   /// preceded by (at least) one call to update_state().
   virtual void write_state(LightState *state) = 0;
+
+  /// Return whether this output can fade to new values in hardware with write_state_fade(). Transitions then only
+  /// write the values at the end of each segment, instead of a new value on every loop.
+  virtual bool supports_fade() { return false; }
+
+  /// Write the state to hardware like write_state(), fading to it over length milliseconds.
+  virtual void write_state_fade(LightState *state, uint32_t length) { this->write_state(state); }
 };
 
 }  // namespace light
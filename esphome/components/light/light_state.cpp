@@ -8,6 +8,26 @@ namespace light {
 
 static const char *const TAG = "light";
 
+/// Smallest change of a channel during a transition that is written to the output
+static const float TRANSITION_WRITE_THRESHOLD = 1.0f / 65535.0f;
+/// Smallest change of the color temperature (in mireds) during a transition that is written to the output
+static const float TRANSITION_WRITE_THRESHOLD_MIREDS = 0.01f;
+
+/// Length of the segments transitions are split into on outputs that fade in hardware, in milliseconds
+static const uint32_t FADE_SEGMENT_LENGTH = 100;
+
+/// Whether the step of a transition from a to b changes what is written to the output.
+static bool transition_step_visible(const LightColorValues &a, const LightColorValues &b) {
+  auto differ = [](float x, float y) { return fabsf(x - y) >= TRANSITION_WRITE_THRESHOLD; };
+  return a.get_color_mode() != b.get_color_mode() || a.is_on() != b.is_on() ||
+         differ(a.get_state(), b.get_state()) || differ(a.get_brightness(), b.get_brightness()) ||
+         differ(a.get_color_brightness(), b.get_color_brightness()) || differ(a.get_red(), b.get_red()) ||
+         differ(a.get_green(), b.get_green()) || differ(a.get_blue(), b.get_blue()) ||
+         differ(a.get_white(), b.get_white()) || differ(a.get_cold_white(), b.get_cold_white()) ||
+         differ(a.get_warm_white(), b.get_warm_white()) ||
+         fabsf(a.get_color_temperature() - b.get_color_temperature()) >= TRANSITION_WRITE_THRESHOLD_MIREDS;
+}
+
 LightState::LightState(LightOutput *output) : output_(output) {}
 
 LightTraits LightState::get_traits() { return this->output_->get_traits(); }
@@ -119,11 +139,16 @@ void LightState::loop() {
 
   // Apply transformer (if any)
   if (this->transformer_ != nullptr) {
-    auto values = this->transformer_->apply();
+    // Outputs that fade in hardware only need the values at the end of each segment of the transition
+    optional<LightColorValues> values = {};
+    if (!(this->output_->supports_fade() && this->apply_fade_segment_()))
+      values = this->transformer_->apply();
     if (values.has_value()) {
       this->current_values = *values;
       this->output_->update_state(this);
-      this->next_write_ = true;
+      // Transitions run every loop, skip writing steps too small to change the output
+      if (transition_step_visible(this->current_values, this->written_values_))
+        this->next_write_ = true;
     }
 
     if (this->transformer_->is_finished()) {
@@ -139,10 +164,37 @@ void LightState::loop() {
   // Write state to the light
   if (this->next_write_) {
     this->next_write_ = false;
-    this->output_->write_state(this);
+    this->written_values_ = this->current_values;
+    if (this->fade_length_ > 0) {
+      this->output_->write_state_fade(this, this->fade_length_);
+      this->fade_length_ = 0;
+    } else {
+      this->output_->write_state(this);
+    }
   }
 }
 
+bool LightState::apply_fade_segment_() {
+  const uint32_t now = millis();
+  if (now < this->fade_segment_end_)
+    return true;
+
+  const uint32_t end = this->transformer_->get_end_time();
+  const uint32_t length = end > now ? std::min(FADE_SEGMENT_LENGTH, end - now) : 0;
+  auto values = this->transformer_->apply_at(now + length);
+  if (!values.has_value())
+    return false;
+
+  this->current_values = *values;
+  this->output_->update_state(this);
+  if (transition_step_visible(this->current_values, this->written_values_)) {
+    this->fade_segment_end_ = now + length;
+    this->fade_length_ = length;
+    this->next_write_ = true;
+  }
+  return true;
+}
+
 float LightState::get_setup_priority() const { return setup_priority::HARDWARE - 1.0f; }
 
 void LightState::publish_state() { this->remote_values_callback_.call(); }
@@ -239,6 +291,7 @@ void LightState::stop_effect_() {
 }
 
 void LightState::start_transition_(const LightColorValues &target, uint32_t length, bool set_remote_values) {
+  this->stop_fade_();
   this->transformer_ = this->output_->create_default_transition();
   this->transformer_->setup(this->current_values, target, length);
 
@@ -254,6 +307,7 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
   if (this->transformer_ != nullptr)
     end_colors = this->transformer_->get_start_values();
 
+  this->stop_fade_();
   this->transformer_ = make_unique<LightFlashTransformer>(*this);
   this->transformer_->setup(end_colors, target, length);
 
@@ -263,6 +317,7 @@ void LightState::start_flash_(const LightColorValues &target, uint32_t length, b
 }
 
 void LightState::set_immediately_(const LightColorValues &target, bool set_remote_values) {
+  this->stop_fade_();
   this->transformer_ = nullptr;
   this->current_values = target;
   if (set_remote_values) {
@@ -272,6 +327,11 @@ void LightState::set_immediately_(const LightColorValues &target, bool set_remot
   this->next_write_ = true;
 }
 
+void LightState::stop_fade_() {
+  this->fade_segment_end_ = 0;
+  this->fade_length_ = 0;
+}
+
 void LightState::save_remote_values_() {
   LightStateRTCState saved;
   saved.color_mode = this->remote_values.get_color_mode();
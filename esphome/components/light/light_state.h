@@ -164,6 +164,12 @@ class LightState : public EntityBase, public Component {
   /// Internal method to set the color values to target immediately (with no transition).
   void set_immediately_(const LightColorValues &target, bool set_remote_values);
 
+  /// Internal method to fade to the values at the end of the next transition segment, if the transformer supports it.
+  bool apply_fade_segment_();
+  /// Internal method to forget the fade segment in progress, so the next write is applied immediately. That write
+  /// stops the hardware fade of the output.
+  void stop_fade_();
+
   /// Internal method to save the current remote_values to the preferences
   void save_remote_values_();
 
@@ -175,6 +181,12 @@ class LightState : public EntityBase, public Component {
   std::unique_ptr<LightTransformer> transformer_{nullptr};
   /// Whether the light value should be written in the next cycle.
   bool next_write_{true};
+  /// The color values last written to the output.
+  LightColorValues written_values_{};
+  /// The time (in millis()) at which the fade of the output to the current values ends.
+  uint32_t fade_segment_end_{0};
+  /// The length of the fade to use for the next write, 0 to write immediately.
+  uint32_t fade_length_{0};
 
   /// Object used to store the persisted values of the light.
   ESPPreferenceObject rtc_;
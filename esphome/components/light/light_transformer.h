@@ -30,6 +30,10 @@ class LightTransformer {
   /// light directly, or return LightColorValues that will be applied.
   virtual optional<LightColorValues> apply() = 0;
 
+  /// The values of the transformation at the given time (in millis()), used for outputs that fade in hardware.
+  /// Transformers that can't look ahead return nothing, in which case apply() is called on every loop instead.
+  virtual optional<LightColorValues> apply_at(uint32_t time) { return {}; }
+
   /// This will be called after transition is finished.
   virtual void stop() {}
 
@@ -37,10 +41,14 @@ class LightTransformer {
 
   const LightColorValues &get_target_values() const { return this->target_values_; }
 
+  /// The time (in millis()) at which this transformation ends.
+  uint32_t get_end_time() const { return this->start_time_ + this->length_; }
+
  protected:
   /// The progress of this transition, on a scale of 0 to 1.
-  float get_progress_() {
-    uint32_t now = esphome::millis();
+  float get_progress_() { return this->get_progress_(esphome::millis()); }
+  /// The progress of this transition at the given time, on a scale of 0 to 1.
+  float get_progress_(uint32_t now) {
     if (now < this->start_time_)
       return 0.0f;
     if (now >= this->start_time_ + this->length_)
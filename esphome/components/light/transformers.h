@@ -35,8 +35,10 @@ class LightTransitionTransformer : public LightTransformer {
     }
   }
 
-  optional<LightColorValues> apply() override {
-    float p = this->get_progress_();
+  optional<LightColorValues> apply() override { return this->apply_at(millis()); }
+
+  optional<LightColorValues> apply_at(uint32_t time) override {
+    float p = this->get_progress_(time);
 
     // Halfway through, when intermediate state (off) is reached, flip it to the target, but remain off.
     if (this->changing_color_mode_ && p > 0.5f &&
@@ -76,3 +76,8 @@ AddressableFireworksEffect = light_ns.class_(
 AddressableFlickerEffect = light_ns.class_(
     "AddressableFlickerEffect", AddressableLightEffect
 )
+AddressableShaderEffect = light_ns.class_(
+    "AddressableShaderEffect", AddressableLightEffect
+)
+ShaderBlendMode = light_ns.enum("ShaderBlendMode")
+make_shader_layer = light_ns.make_shader_layer
@@ -2,6 +2,10 @@
 
 #include "esphome/core/entity_base.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/ring_buffer.h"
+
+#include <memory>
+#include <vector>
 
 namespace esphome {
 namespace microphone {
@@ -20,8 +24,16 @@ class Microphone {
   void add_data_callback(std::function<void(const std::vector<int16_t> &)> &&data_callback) {
     this->data_callbacks_.add(std::move(data_callback));
   }
+  /// Copy up to len bytes of captured 16-bit samples into buf, returns the number of bytes copied.
   virtual size_t read(int16_t *buf, size_t len) = 0;
 
+  /** Return the buffer the captured 16-bit samples are written to while running, or nullptr if there is none.
+   *
+   * Allows the consumer of the audio to process the samples in place instead of copying them with read(). The buffer
+   * has a single consumer, so this can't be combined with read() or data callbacks.
+   */
+  RingBuffer *get_ring_buffer() { return this->ring_buffer_.get(); }
+
   bool is_running() const { return this->state_ == STATE_RUNNING; }
   bool is_stopped() const { return this->state_ == STATE_STOPPED; }
 
@@ -29,6 +41,7 @@ class Microphone {
   State state_{STATE_STOPPED};
 
   CallbackManager<void(const std::vector<int16_t> &)> data_callbacks_{};
+  std::unique_ptr<RingBuffer> ring_buffer_;
 };
 
 }  // namespace microphone
@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace modbus {
 
@@ -21,20 +23,52 @@ void Modbus::loop() {
   }
   // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
   if (now - this->last_send_ > send_wait_time_) {
+    if (waiting_for_response != 0) {
+      this->timeout_count_++;
+      this->busy_time_ += this->send_wait_time_;
+    }
     waiting_for_response = 0;
+    this->active_device_ = nullptr;
   }
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
-    } else {
-      this->rx_buffer_.clear();
+  uint8_t buf[64];
+  size_t len;
+  while ((len = this->read_available(buf, sizeof(buf))) > 0) {
+    for (size_t i = 0; i < len; i++) {
+      if (this->parse_modbus_byte_(buf[i])) {
+        this->last_modbus_byte_ = now;
+      } else {
+        this->rx_buffer_.clear();
+      }
+    }
+  }
+
+  if (waiting_for_response == 0)
+    this->schedule_next_device_();
+}
+
+void Modbus::schedule_next_device_() {
+  const size_t count = this->devices_.size();
+  for (size_t i = 0; i < count; i++) {
+    size_t index = (this->next_device_ + i) % count;
+    this->scheduled_device_ = this->devices_[index];
+    bool sent = this->scheduled_device_->on_modbus_idle();
+    this->scheduled_device_ = nullptr;
+    if (sent) {
+      // start with the following device next time, so one busy device can't starve the others
+      this->next_device_ = (index + 1) % count;
+      return;
     }
   }
 }
 
+void Modbus::on_request_sent_(uint8_t address) {
+  this->active_device_ = this->scheduled_device_;
+  waiting_for_response = address;
+  this->last_send_ = millis();
+  this->request_count_++;
+}
+
 bool Modbus::parse_modbus_byte_(uint8_t byte) {
   size_t at = this->rx_buffer_.size();
   this->rx_buffer_.push_back(byte);
@@ -111,8 +145,19 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
     }
   }
   std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
+  if (waiting_for_response != 0) {
+    uint32_t latency = millis() - this->last_send_;
+    this->response_count_++;
+    this->total_latency_ += latency;
+    this->busy_time_ += latency;
+    this->max_latency_ = std::max(this->max_latency_, latency);
+  }
+
   bool found = false;
   for (auto *device : this->devices_) {
+    // if the pending request is known to come from one device, don't hand the response to others sharing the address
+    if (waiting_for_response != 0 && this->active_device_ != nullptr && this->active_device_ != device)
+      continue;
     if (device->address_ == address) {
       // Is it an error response?
       if ((function_code & 0x80) == 0x80) {
@@ -130,6 +175,7 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
     }
   }
   waiting_for_response = 0;
+  this->active_device_ = nullptr;
 
   if (!found) {
     ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X! ", address);
@@ -194,8 +240,7 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
 
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = address;
-  last_send_ = millis();
+  this->on_request_sent_(address);
   ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
 }
 
@@ -216,9 +261,8 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
   this->flush();
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = payload[0];
+  this->on_request_sent_(payload[0]);
   ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
-  last_send_ = millis();
 }
 
 }  // namespace modbus
@@ -32,9 +32,28 @@ class Modbus : public uart::UARTDevice, public Component {
   void set_send_wait_time(uint16_t time_in_ms) { send_wait_time_ = time_in_ms; }
   void set_disable_crc(bool disable_crc) { disable_crc_ = disable_crc; }
 
+  /// Number of requests sent since boot
+  uint32_t get_request_count() const { return this->request_count_; }
+  /// Number of requests that did not get a response within send_wait_time
+  uint32_t get_timeout_count() const { return this->timeout_count_; }
+  /// Average time in ms between sending a request and receiving its response
+  float get_average_latency() const {
+    return this->response_count_ == 0 ? 0.0f : float(this->total_latency_) / float(this->response_count_);
+  }
+  /// Longest time in ms between sending a request and receiving its response
+  uint32_t get_max_latency() const { return this->max_latency_; }
+  /// Fraction of time since boot the bus spent waiting for responses
+  float get_bus_utilisation() const {
+    uint32_t uptime = millis();
+    return uptime == 0 ? 0.0f : float(this->busy_time_) / float(uptime);
+  }
+
  protected:
   GPIOPin *flow_control_pin_{nullptr};
 
+  /// give the next device with pending requests a chance to use the idle bus (round robin)
+  void schedule_next_device_();
+  void on_request_sent_(uint8_t address);
   bool parse_modbus_byte_(uint8_t byte);
   uint16_t send_wait_time_{250};
   bool disable_crc_;
@@ -42,6 +61,18 @@ class Modbus : public uart::UARTDevice, public Component {
   uint32_t last_modbus_byte_{0};
   uint32_t last_send_{0};
   std::vector<ModbusDevice *> devices_;
+  size_t next_device_{0};
+  /// device currently sending from on_modbus_idle
+  ModbusDevice *scheduled_device_{nullptr};
+  /// device that sent the pending request, if it was sent from on_modbus_idle
+  ModbusDevice *active_device_{nullptr};
+
+  uint32_t request_count_{0};
+  uint32_t response_count_{0};
+  uint32_t timeout_count_{0};
+  uint32_t total_latency_{0};
+  uint32_t max_latency_{0};
+  uint32_t busy_time_{0};
 };
 
 class ModbusDevice {
@@ -50,6 +81,8 @@ class ModbusDevice {
   void set_address(uint8_t address) { address_ = address; }
   virtual void on_modbus_data(const std::vector<uint8_t> &data) = 0;
   virtual void on_modbus_error(uint8_t function_code, uint8_t exception_code) {}
+  /// Called by the bus when no response is pending. Return true if a request was sent.
+  virtual bool on_modbus_idle() { return false; }
   void send(uint8_t function, uint16_t start_address, uint16_t number_of_entities, uint8_t payload_len = 0,
             const uint8_t *payload = nullptr) {
     this->parent_->send(this->address_, function, start_address, number_of_entities, payload_len, payload);
@@ -2,7 +2,14 @@ import binascii
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import modbus
-from esphome.const import CONF_ADDRESS, CONF_ID, CONF_NAME, CONF_LAMBDA, CONF_OFFSET
+from esphome.const import (
+    CONF_ADDRESS,
+    CONF_ID,
+    CONF_NAME,
+    CONF_LAMBDA,
+    CONF_OFFSET,
+    CONF_PRIORITY,
+)
 from esphome.cpp_helpers import logging
 from .const import (
     CONF_BITMASK,
@@ -11,6 +18,7 @@ from .const import (
     CONF_OFFLINE_SKIP_UPDATES,
     CONF_CUSTOM_COMMAND,
     CONF_FORCE_NEW_RANGE,
+    CONF_MAX_REGISTER_GAP,
     CONF_MODBUS_CONTROLLER_ID,
     CONF_REGISTER_COUNT,
     CONF_REGISTER_TYPE,
@@ -106,6 +114,9 @@ CONFIG_SCHEMA = cv.All(
                 CONF_COMMAND_THROTTLE, default="0ms"
             ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_OFFLINE_SKIP_UPDATES, default=0): cv.positive_int,
+            cv.Optional(CONF_MAX_REGISTER_GAP, default=0): cv.int_range(
+                min=0, max=124
+            ),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -131,6 +142,7 @@ ModbusItemBaseSchema = cv.Schema(
         cv.Optional(CONF_BITMASK, default=0xFFFFFFFF): cv.hex_uint32_t,
         cv.Optional(CONF_SKIP_UPDATES, default=0): cv.positive_int,
         cv.Optional(CONF_FORCE_NEW_RANGE, default=False): cv.boolean,
+        cv.Optional(CONF_PRIORITY, default=0): cv.uint8_t,
         cv.Optional(CONF_LAMBDA): cv.returning_lambda,
         cv.Optional(CONF_RESPONSE_SIZE, default=0): cv.positive_int,
     },
@@ -191,6 +203,9 @@ async def add_modbus_base_properties(
     if config[CONF_RESPONSE_SIZE] > 0:
         cg.add(var.set_register_size(config[CONF_RESPONSE_SIZE]))
 
+    if config[CONF_PRIORITY] > 0:
+        cg.add(var.set_priority(config[CONF_PRIORITY]))
+
     if CONF_LAMBDA in config:
         template_ = await cg.process_lambda(
             config[CONF_LAMBDA],
@@ -211,6 +226,7 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
     cg.add(var.set_offline_skip_updates(config[CONF_OFFLINE_SKIP_UPDATES]))
+    cg.add(var.set_max_register_gap(config[CONF_MAX_REGISTER_GAP]))
     await register_modbus_device(var, config)
 
 
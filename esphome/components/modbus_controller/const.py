@@ -5,6 +5,7 @@ CONF_OFFLINE_SKIP_UPDATES = "offline_skip_updates"
 CONF_CUSTOM_COMMAND = "custom_command"
 CONF_FORCE_NEW_RANGE = "force_new_range"
 CONF_MODBUS_CONTROLLER_ID = "modbus_controller_id"
+CONF_MAX_REGISTER_GAP = "max_register_gap"
 CONF_MODBUS_FUNCTIONCODE = "modbus_functioncode"
 CONF_RAW_ENCODE = "raw_encode"
 CONF_REGISTER_COUNT = "register_count"
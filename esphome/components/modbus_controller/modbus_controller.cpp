@@ -2,6 +2,8 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace modbus_controller {
 
@@ -14,10 +16,14 @@ void ModbusController::setup() {
 
 /*
  To work with the existing modbus class and avoid polling for responses a command queue is used.
+ The modbus bus calls on_modbus_idle for each device in turn whenever no response is pending.
  send_next_command will submit the command at the top of the queue and set the corresponding callback
  to handle the response from the device.
- Once the response has been processed it is removed from the queue and the next command is sent
+ Once the response has been received it is removed from the queue and the next command can be sent,
+ while the response is processed in loop.
 */
+bool ModbusController::on_modbus_idle() { return this->send_next_command_(); }
+
 bool ModbusController::send_next_command_() {
   uint32_t last_send = millis() - this->last_command_timestamp_;
 
@@ -51,9 +57,10 @@ bool ModbusController::send_next_command_() {
       if (!command->on_data_func) {
         command_queue_.pop_front();
       }
+      return true;
     }
   }
-  return (!command_queue_.empty());
+  return false;
 }
 
 // Queue incoming response
@@ -140,7 +147,23 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
       return;
     }
   }
-  command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  if (command.is_write()) {
+    // writes are user initiated, let them overtake pending reads but not a command awaiting its response
+    auto it = command_queue_.begin();
+    while (it != command_queue_.end() && ((*it)->is_write() || (*it)->was_sent()))
+      it++;
+    command_queue_.insert(it, make_unique<ModbusCommandItem>(command));
+    return;
+  }
+  // reads are queued behind the commands with the same or a higher priority
+  auto it = command_queue_.end();
+  while (it != command_queue_.begin()) {
+    auto prev = std::prev(it);
+    if ((*prev)->is_write() || (*prev)->was_sent() || (*prev)->priority >= command.priority)
+      break;
+    it = prev;
+  }
+  command_queue_.insert(it, make_unique<ModbusCommandItem>(command));
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -160,10 +183,14 @@ void ModbusController::update_range_(RegisterRange &r) {
         command_item.register_address = (*sensor)->start_address;
         command_item.register_count = (*sensor)->register_count;
         command_item.function_code = ModbusFunctionCode::CUSTOM;
+        command_item.priority = r.priority;
         queue_command(command_item);
       }
     } else {
-      queue_command(ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count));
+      auto command_item =
+          ModbusCommandItem::create_read_command(this, r.register_type, r.start_address, r.register_count);
+      command_item.priority = r.priority;
+      queue_command(command_item);
     }
     r.skip_updates_counter = r.skip_updates;  // reset counter to config value
   } else {
@@ -180,6 +207,11 @@ void ModbusController::update() {
   } else {
     ESP_LOGV(TAG, "Updating modbus component");
   }
+  ESP_LOGV(TAG, "Bus stats: requests=%" PRIu32 " timeouts=%" PRIu32 " latency avg=%.1fms max=%" PRIu32
+                "ms utilisation=%.1f%%",
+           this->parent_->get_request_count(), this->parent_->get_timeout_count(),
+           this->parent_->get_average_latency(), this->parent_->get_max_latency(),
+           this->parent_->get_bus_utilisation() * 100.0f);
 
   for (auto &r : this->register_ranges_) {
     ESP_LOGVV(TAG, "Updating range 0x%X", r.start_address);
@@ -214,6 +246,7 @@ size_t ModbusController::create_register_ranges_() {
       r.sensors.insert(curr);
       r.skip_updates = curr->skip_updates;
       r.skip_updates_counter = 0;
+      r.priority = curr->priority;
       buffer_offset = curr->get_register_size();
 
       ESP_LOGV(TAG, "Started new range");
@@ -238,23 +271,28 @@ size_t ModbusController::create_register_ranges_() {
 
           ESP_LOGV(TAG, "Re-use previous register - change to register: 0x%X %d offset=%u", curr->start_address,
                    curr->register_count, curr->offset);
-        } else if (curr->start_address == (r.start_address + r.register_count)) {
-          // this register can extend the current range
+        } else if (curr->start_address >= (r.start_address + r.register_count) &&
+                   curr->start_address - (r.start_address + r.register_count) <= this->gap_for_(curr) &&
+                   (curr->start_address == r.start_address + r.register_count ||
+                    curr->start_address + curr->register_count - r.start_address <= MAX_RANGE_REGISTERS)) {
+          // this register can extend the current range, possibly reading across a small unused gap
+          uint16_t gap = curr->start_address - (r.start_address + r.register_count);
 
           // remove this sensore because start_address is changed (sort-order)
           ix = sensorset_.erase(ix);
 
+          buffer_offset += gap * 2;
           curr->start_address = r.start_address;
           curr->offset += buffer_offset;
           buffer_offset += curr->get_register_size();
-          r.register_count += curr->register_count;
+          r.register_count += gap + curr->register_count;
 
           sensorset_.insert(curr);
           // move iterator backwards because it will be incremented later
           ix--;
 
-          ESP_LOGV(TAG, "Extend range - change to register: 0x%X %d offset=%u", curr->start_address,
-                   curr->register_count, curr->offset);
+          ESP_LOGV(TAG, "Extend range - change to register: 0x%X %d offset=%u gap=%u", curr->start_address,
+                   curr->register_count, curr->offset, gap);
         }
       }
     }
@@ -270,6 +308,8 @@ size_t ModbusController::create_register_ranges_() {
         }
       }
 
+      r.priority = std::max(r.priority, curr->priority);
+
       // add sensor to this range
       r.sensors.insert(curr);
 
@@ -294,9 +334,20 @@ size_t ModbusController::create_register_ranges_() {
   return register_ranges_.size();
 }
 
+uint16_t ModbusController::gap_for_(const SensorItem *item) const {
+  // coils and discrete inputs are packed as bits, skipping over them would break the offsets
+  if (item->register_type != ModbusRegisterType::HOLDING && item->register_type != ModbusRegisterType::READ)
+    return 0;
+  // registers returning a non standard size can't be combined with a gap
+  if (item->response_bytes > 0)
+    return 0;
+  return this->max_register_gap_;
+}
+
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+  ESP_LOGCONFIG(TAG, "  Max Register Gap: %u", this->max_register_gap_);
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
@@ -306,8 +357,9 @@ void ModbusController::dump_config() {
   }
   ESP_LOGCONFIG(TAG, "ranges");
   for (auto &it : register_ranges_) {
-    ESP_LOGCONFIG(TAG, "  Range type=%zu start=0x%X count=%d skip_updates=%d", static_cast<uint8_t>(it.register_type),
-                  it.start_address, it.register_count, it.skip_updates);
+    ESP_LOGCONFIG(TAG, "  Range type=%zu start=0x%X count=%d skip_updates=%d priority=%u",
+                  static_cast<uint8_t>(it.register_type), it.start_address, it.register_count, it.skip_updates,
+                  it.priority);
   }
 #endif
 }
@@ -320,9 +372,6 @@ void ModbusController::loop() {
       process_modbus_data_(message.get());
     incoming_queue_.pop();
 
-  } else {
-    // all messages processed send pending commands
-    send_next_command_();
   }
 }
 
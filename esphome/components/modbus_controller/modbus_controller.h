@@ -239,6 +239,7 @@ class SensorItem {
   }
   // Override register size for modbus devices not using 1 register for one dword
   void set_register_size(uint8_t register_size) { response_bytes = register_size; }
+  void set_priority(uint8_t priority) { this->priority = priority; }
   ModbusRegisterType register_type;
   SensorValueType sensor_value_type;
   uint16_t start_address;
@@ -247,6 +248,8 @@ class SensorItem {
   uint8_t register_count;
   uint8_t response_bytes{0};
   uint16_t skip_updates;
+  /// registers with a higher priority are read first when several reads are waiting
+  uint8_t priority{0};
   std::vector<uint8_t> custom_data{};
   bool force_new_range{false};
 };
@@ -291,6 +294,7 @@ struct RegisterRange {
   uint16_t skip_updates;          // the config value
   SensorSet sensors;              // all sensors of this range
   uint16_t skip_updates_counter;  // the running value
+  uint8_t priority;               // the highest priority of the sensors
 };
 
 class ModbusCommandItem {
@@ -309,6 +313,8 @@ class ModbusCommandItem {
   // wrong commands (esp. custom commands) can block the send queue
   // limit the number of repeats
   uint8_t send_countdown{MAX_SEND_REPEATS};
+  /// reads with a higher priority are sent before queued reads with a lower one
+  uint8_t priority{0};
   /// factory methods
   /** Create modbus read command
    *  Function code 02-04
@@ -397,6 +403,15 @@ class ModbusCommandItem {
           &&handler = nullptr);
 
   bool is_equal(const ModbusCommandItem &other);
+  /// true for commands changing the state of the device
+  bool is_write() const {
+    return this->function_code == ModbusFunctionCode::WRITE_SINGLE_COIL ||
+           this->function_code == ModbusFunctionCode::WRITE_SINGLE_REGISTER ||
+           this->function_code == ModbusFunctionCode::WRITE_MULTIPLE_COILS ||
+           this->function_code == ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS;
+  }
+  /// true once the command was sent at least once and may be waiting for its response
+  bool was_sent() const { return this->send_countdown < MAX_SEND_REPEATS; }
 };
 
 /** Modbus controller class.
@@ -409,6 +424,9 @@ class ModbusCommandItem {
 
 class ModbusController : public PollingComponent, public modbus::ModbusDevice {
  public:
+  /// max number of registers read by one command (limit of function codes 3 and 4)
+  static const uint16_t MAX_RANGE_REGISTERS = 125;
+
   void dump_config() override;
   void loop() override;
   void setup() override;
@@ -422,6 +440,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void on_modbus_data(const std::vector<uint8_t> &data) override;
   /// called when a modbus error response was received
   void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
+  /// called by the modbus bus when it is free to send the next command
+  bool on_modbus_idle() override;
   /// default delegate called by process_modbus_data when a response has retrieved from the incoming queue
   void on_register_data(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data);
   /// default delegate called by process_modbus_data when a response for a write response has retrieved from the
@@ -432,6 +452,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
   /// called by esphome generated code to set the offline_skip_updates
   void set_offline_skip_updates(uint16_t offline_skip_updates) { this->offline_skip_updates_ = offline_skip_updates; }
+  /// called by esphome generated code to set the number of unused registers a range may read across
+  void set_max_register_gap(uint16_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
   /// get the number of queued modbus commands (should be mostly empty)
   size_t get_command_queue_length() { return command_queue_.size(); }
   /// get if the module is offline, didn't respond the last command
@@ -440,13 +462,15 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
  protected:
   /// parse sensormap_ and create range of sequential addresses
   size_t create_register_ranges_();
+  /// max number of unused registers to read across when combining sensors into one range
+  uint16_t gap_for_(const SensorItem *item) const;
   // find register in sensormap. Returns iterator with all registers having the same start address
   SensorSet find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const;
   /// submit the read command for the address range to the send queue
   void update_range_(RegisterRange &r);
   /// parse incoming modbus data
   void process_modbus_data_(const ModbusCommandItem *response);
-  /// send the next modbus command from the send queue
+  /// send the next modbus command from the send queue, returns true if a command was sent
   bool send_next_command_();
   /// dump the parsed sensormap for diagnostics
   void dump_sensors_();
@@ -466,6 +490,8 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   bool module_offline_;
   /// how many updates to skip if module is offline
   uint16_t offline_skip_updates_;
+  /// how many unused registers may be read to combine two ranges
+  uint16_t max_register_gap_{0};
 };
 
 /** Convert vector<uint8_t> response payload to float.
@@ -0,0 +1,95 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import modbus
+from esphome.const import (
+    CONF_ADDRESS,
+    CONF_COUNT,
+    CONF_ID,
+    CONF_PORT,
+)
+
+DEPENDENCIES = ["modbus", "network"]
+AUTO_LOAD = ["socket"]
+
+CONF_CACHE = "cache"
+CONF_CACHE_TTL = "cache_ttl"
+CONF_FUNCTION_CODE = "function_code"
+CONF_MAX_CACHED_REGISTERS = "max_cached_registers"
+CONF_MAX_CLIENTS = "max_clients"
+CONF_MAX_PENDING_REQUESTS = "max_pending_requests"
+CONF_RESPONSE_TIMEOUT = "response_timeout"
+CONF_TTL = "ttl"
+CONF_UNIT = "unit"
+
+modbus_tcp_ns = cg.esphome_ns.namespace("modbus_tcp")
+ModbusTCPServer = modbus_tcp_ns.class_(
+    "ModbusTCPServer", cg.Component, modbus.ModbusDevice
+)
+
+READ_FUNCTION_CODES = {
+    "read_holding_registers": 0x03,
+    "read_input_registers": 0x04,
+}
+
+CACHE_RULE_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_UNIT): cv.int_range(min=1, max=247),
+        cv.Optional(CONF_FUNCTION_CODE, default="read_holding_registers"): cv.enum(
+            READ_FUNCTION_CODES
+        ),
+        cv.Required(CONF_ADDRESS): cv.uint16_t,
+        cv.Optional(CONF_COUNT, default=1): cv.int_range(min=1, max=0xFFFF),
+        cv.Required(CONF_TTL): cv.positive_time_period_milliseconds,
+    }
+)
+
+CONFIG_SCHEMA = (
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ModbusTCPServer),
+            cv.GenerateID(modbus.CONF_MODBUS_ID): cv.use_id(modbus.Modbus),
+            cv.Optional(CONF_PORT, default=502): cv.port,
+            cv.Optional(CONF_MAX_CLIENTS, default=4): cv.int_range(min=1, max=16),
+            cv.Optional(CONF_MAX_PENDING_REQUESTS, default=16): cv.int_range(
+                min=1, max=255
+            ),
+            cv.Optional(
+                CONF_RESPONSE_TIMEOUT, default="1s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_CACHE_TTL, default="0s"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_CACHED_REGISTERS, default=256): cv.int_range(
+                min=0, max=0xFFFF
+            ),
+            cv.Optional(CONF_CACHE, default=[]): cv.ensure_list(CACHE_RULE_SCHEMA),
+        }
+    )
+    .extend(cv.COMPONENT_SCHEMA)
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    parent = await cg.get_variable(config[modbus.CONF_MODBUS_ID])
+    cg.add(var.set_parent(parent))
+    cg.add(parent.register_device(var))
+
+    cg.add(var.set_port(config[CONF_PORT]))
+    cg.add(var.set_max_clients(config[CONF_MAX_CLIENTS]))
+    cg.add(var.set_max_pending_requests(config[CONF_MAX_PENDING_REQUESTS]))
+    cg.add(var.set_response_timeout(config[CONF_RESPONSE_TIMEOUT]))
+    cg.add(var.set_cache_ttl(config[CONF_CACHE_TTL]))
+    cg.add(var.set_max_cached_registers(config[CONF_MAX_CACHED_REGISTERS]))
+    for rule in config[CONF_CACHE]:
+        cg.add(
+            var.add_cache_rule(
+                rule[CONF_UNIT],
+                rule[CONF_FUNCTION_CODE],
+                rule[CONF_ADDRESS],
+                rule[CONF_COUNT],
+                rule[CONF_TTL],
+            )
+        )
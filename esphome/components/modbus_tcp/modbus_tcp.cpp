@@ -0,0 +1,399 @@
+#include "modbus_tcp.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+
+namespace esphome {
+namespace modbus_tcp {
+
+static const char *const TAG = "modbus_tcp";
+
+/// MBAP header: transaction id, protocol id, length and unit id
+static const size_t MBAP_HEADER_SIZE = 7;
+/// Largest Modbus PDU plus the unit id, as counted by the MBAP length field
+static const uint16_t MAX_MBAP_LENGTH = 254;
+
+void ModbusTCPServer::setup() {
+  ESP_LOGCONFIG(TAG, "Setting up Modbus TCP server...");
+  this->socket_ = socket::socket_ip(SOCK_STREAM, 0);
+  if (this->socket_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    this->mark_failed();
+    return;
+  }
+  int enable = 1;
+  int err = this->socket_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set reuseaddr: errno %d", err);
+    // we can still continue
+  }
+  err = this->socket_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+    this->mark_failed();
+    return;
+  }
+
+  struct sockaddr_storage server;
+  socklen_t sl = socket::set_sockaddr_any((struct sockaddr *) &server, sizeof(server), this->port_);
+  if (sl == 0) {
+    ESP_LOGW(TAG, "Socket unable to set sockaddr: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+
+  err = this->socket_->bind((struct sockaddr *) &server, sl);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+
+  err = this->socket_->listen(this->max_clients_);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to listen: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+}
+
+void ModbusTCPServer::loop() {
+  this->accept_clients_();
+
+  for (auto &client : this->clients_) {
+    if (!client.remove)
+      this->read_client_(client);
+  }
+
+  auto new_end = std::remove_if(this->clients_.begin(), this->clients_.end(), [](const ModbusTCPClient &client) {
+    if (client.remove)
+      ESP_LOGD(TAG, "Client %" PRIu32 " disconnected", client.id);
+    return client.remove;
+  });
+  this->clients_.erase(new_end, this->clients_.end());
+
+  if (this->pending_ != nullptr && millis() - this->pending_since_ > this->response_timeout_) {
+    ESP_LOGW(TAG, "No response from unit %u for function 0x%02X", this->pending_->unit, this->pending_->function_code);
+    this->send_exception_(*this->pending_, GATEWAY_TARGET_NO_RESPONSE);
+    this->pending_.reset();
+  }
+}
+
+void ModbusTCPServer::dump_config() {
+  ESP_LOGCONFIG(TAG, "Modbus TCP Server:");
+  ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+  ESP_LOGCONFIG(TAG, "  Max Clients: %u", this->max_clients_);
+  ESP_LOGCONFIG(TAG, "  Max Pending Requests: %u", this->max_pending_requests_);
+  ESP_LOGCONFIG(TAG, "  Response Timeout: %" PRIu32 " ms", this->response_timeout_);
+  ESP_LOGCONFIG(TAG, "  Cache TTL: %" PRIu32 " ms", this->cache_ttl_);
+  ESP_LOGCONFIG(TAG, "  Max Cached Registers: %u", this->max_cached_registers_);
+  for (auto &rule : this->cache_rules_) {
+    ESP_LOGCONFIG(TAG, "  Cache Rule: unit=%u function=0x%02X start=0x%04X count=%u ttl=%" PRIu32 " ms", rule.unit,
+                  rule.function_code, rule.start_address, rule.count, rule.ttl);
+  }
+}
+
+void ModbusTCPServer::accept_clients_() {
+  while (true) {
+    struct sockaddr_storage source_addr;
+    socklen_t addr_len = sizeof(source_addr);
+    auto sock = this->socket_->accept((struct sockaddr *) &source_addr, &addr_len);
+    if (!sock)
+      break;
+    if (this->clients_.size() >= this->max_clients_) {
+      ESP_LOGW(TAG, "Rejecting %s, too many clients", sock->getpeername().c_str());
+      sock->close();
+      continue;
+    }
+    int enable = 1;
+    sock->setsockopt(IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(int));
+    sock->setblocking(false);
+
+    ModbusTCPClient client;
+    client.id = this->next_client_id_++;
+    ESP_LOGD(TAG, "Client %" PRIu32 " connected from %s", client.id, sock->getpeername().c_str());
+    client.socket = std::move(sock);
+    this->clients_.push_back(std::move(client));
+  }
+}
+
+void ModbusTCPServer::read_client_(ModbusTCPClient &client) {
+  uint8_t buf[MBAP_HEADER_SIZE + MAX_MBAP_LENGTH];
+  while (true) {
+    ssize_t received = client.socket->read(buf, sizeof(buf));
+    if (received == -1) {
+      if (errno != EWOULDBLOCK && errno != EAGAIN) {
+        ESP_LOGW(TAG, "Client %" PRIu32 " read failed: errno %d", client.id, errno);
+        client.remove = true;
+      }
+      return;
+    }
+    if (received == 0) {
+      client.remove = true;
+      return;
+    }
+    client.rx_buffer.insert(client.rx_buffer.end(), buf, buf + received);
+
+    size_t pos = 0;
+    while (client.rx_buffer.size() - pos >= MBAP_HEADER_SIZE) {
+      const uint8_t *frame = client.rx_buffer.data() + pos;
+      uint16_t length = encode_uint16(frame[4], frame[5]);
+      uint16_t protocol = encode_uint16(frame[2], frame[3]);
+      if (protocol != 0 || length < 2 || length > MAX_MBAP_LENGTH) {
+        ESP_LOGW(TAG, "Client %" PRIu32 " sent an invalid MBAP header", client.id);
+        client.remove = true;
+        return;
+      }
+      size_t frame_len = 6 + length;
+      if (client.rx_buffer.size() - pos < frame_len)
+        break;
+      if (!this->handle_frame_(client, frame, frame_len)) {
+        client.remove = true;
+        return;
+      }
+      pos += frame_len;
+    }
+    client.rx_buffer.erase(client.rx_buffer.begin(), client.rx_buffer.begin() + pos);
+  }
+}
+
+bool ModbusTCPServer::handle_frame_(ModbusTCPClient &client, const uint8_t *frame, size_t len) {
+  const uint8_t *pdu = frame + MBAP_HEADER_SIZE;
+  size_t pdu_len = len - MBAP_HEADER_SIZE;
+
+  ModbusTCPRequest request;
+  request.client_id = client.id;
+  request.transaction_id = encode_uint16(frame[0], frame[1]);
+  request.unit = frame[6];
+  request.function_code = pdu[0];
+
+  if (request.unit == 0 || request.unit > 247) {
+    this->send_exception_(request, GATEWAY_PATH_UNAVAILABLE);
+    return true;
+  }
+
+  switch (request.function_code) {
+    case 0x01:
+    case 0x02:
+    case 0x03:
+    case 0x04: {
+      if (pdu_len != 5)
+        return false;
+      request.start_address = encode_uint16(pdu[1], pdu[2]);
+      request.count = encode_uint16(pdu[3], pdu[4]);
+      uint16_t max_count = request.function_code <= 0x02 ? 128 : 125;
+      if (request.count == 0 || request.count > max_count) {
+        this->send_exception_(request, ILLEGAL_DATA_VALUE);
+        return true;
+      }
+      if (this->serve_from_cache_(request))
+        return true;
+      break;
+    }
+    case 0x05:
+    case 0x06:
+      if (pdu_len != 5)
+        return false;
+      request.start_address = encode_uint16(pdu[1], pdu[2]);
+      request.count = 1;
+      request.payload.assign(pdu + 3, pdu + 5);
+      break;
+    case 0x0F:
+    case 0x10:
+      if (pdu_len < 6 || pdu_len != 6u + pdu[5])
+        return false;
+      request.start_address = encode_uint16(pdu[1], pdu[2]);
+      request.count = encode_uint16(pdu[3], pdu[4]);
+      request.payload.assign(pdu + 6, pdu + pdu_len);
+      break;
+    default:
+      this->send_exception_(request, ILLEGAL_FUNCTION);
+      return true;
+  }
+
+  if (this->queue_.size() >= this->max_pending_requests_) {
+    ESP_LOGW(TAG, "Request queue full, rejecting request from client %" PRIu32, client.id);
+    this->send_exception_(request, SERVER_DEVICE_BUSY);
+    return true;
+  }
+  ESP_LOGV(TAG, "Queued function 0x%02X for unit %u start=0x%04X count=%u", request.function_code, request.unit,
+           request.start_address, request.count);
+  this->queue_.push_back(std::move(request));
+  return true;
+}
+
+bool ModbusTCPServer::on_modbus_idle() {
+  if (this->pending_ != nullptr)
+    return false;
+  while (!this->queue_.empty()) {
+    auto request = make_unique<ModbusTCPRequest>(std::move(this->queue_.front()));
+    this->queue_.pop_front();
+
+    bool connected = false;
+    for (auto &client : this->clients_) {
+      if (client.id == request->client_id && !client.remove)
+        connected = true;
+    }
+    if (!connected)
+      continue;
+
+    // a repeated read may have been answered by an earlier request in the queue
+    if ((request->function_code == 0x03 || request->function_code == 0x04) && this->serve_from_cache_(*request))
+      continue;
+
+    this->address_ = request->unit;
+    this->send(request->function_code, request->start_address, request->count, request->payload.size(),
+               request->payload.empty() ? nullptr : request->payload.data());
+    this->forwarded_requests_++;
+    this->pending_since_ = millis();
+    this->pending_ = std::move(request);
+    return true;
+  }
+  return false;
+}
+
+void ModbusTCPServer::on_modbus_data(const std::vector<uint8_t> &data) {
+  if (this->pending_ == nullptr)
+    return;
+  auto &request = *this->pending_;
+
+  std::vector<uint8_t> pdu;
+  pdu.reserve(data.size() + 2);
+  pdu.push_back(request.function_code);
+  if (request.function_code <= 0x04)
+    pdu.push_back(data.size());
+  pdu.insert(pdu.end(), data.begin(), data.end());
+
+  if (request.function_code == 0x03 || request.function_code == 0x04) {
+    this->update_cache_(request, data);
+  } else if (request.function_code == 0x06 || request.function_code == 0x10) {
+    this->invalidate_cache_(request.unit, request.start_address, request.count);
+  }
+
+  this->send_response_(request.client_id, request.transaction_id, request.unit, pdu);
+  this->pending_.reset();
+}
+
+void ModbusTCPServer::on_modbus_error(uint8_t function_code, uint8_t exception_code) {
+  if (this->pending_ == nullptr)
+    return;
+  this->send_exception_(*this->pending_, exception_code);
+  this->pending_.reset();
+}
+
+bool ModbusTCPServer::serve_from_cache_(const ModbusTCPRequest &request) {
+  // the cached values are outdated as soon as the write is sent, forward the read so it is answered after the write
+  if (request.function_code == 0x03 && this->is_write_pending_(request.unit, request.start_address, request.count))
+    return false;
+  const uint32_t now = millis();
+  std::vector<uint8_t> pdu;
+  pdu.reserve(2 + request.count * 2);
+  pdu.push_back(request.function_code);
+  pdu.push_back(request.count * 2);
+  for (uint16_t i = 0; i < request.count; i++) {
+    auto it = this->cache_.find(cache_key_(request.unit, request.function_code, request.start_address + i));
+    if (it == this->cache_.end() || now - it->second.timestamp > it->second.ttl)
+      return false;
+    pdu.push_back(it->second.value >> 8);
+    pdu.push_back(it->second.value & 0xFF);
+  }
+  this->cache_hits_++;
+  this->send_response_(request.client_id, request.transaction_id, request.unit, pdu);
+  return true;
+}
+
+bool ModbusTCPServer::is_write_pending_(uint8_t unit, uint16_t start_address, uint16_t count) const {
+  auto overlaps = [=](const ModbusTCPRequest &write) {
+    return write.unit == unit && (write.function_code == 0x06 || write.function_code == 0x10) &&
+           uint32_t(write.start_address) < uint32_t(start_address) + count &&
+           uint32_t(start_address) < uint32_t(write.start_address) + write.count;
+  };
+  if (this->pending_ != nullptr && overlaps(*this->pending_))
+    return true;
+  return std::any_of(this->queue_.begin(), this->queue_.end(), overlaps);
+}
+
+void ModbusTCPServer::send_response_(uint32_t client_id, uint16_t transaction_id, uint8_t unit,
+                                     const std::vector<uint8_t> &pdu) {
+  for (auto &client : this->clients_) {
+    if (client.id != client_id || client.remove)
+      continue;
+    uint16_t length = pdu.size() + 1;
+    uint8_t header[MBAP_HEADER_SIZE] = {
+        uint8_t(transaction_id >> 8), uint8_t(transaction_id), 0, 0, uint8_t(length >> 8), uint8_t(length), unit,
+    };
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = const_cast<uint8_t *>(pdu.data());
+    iov[1].iov_len = pdu.size();
+    ssize_t sent = client.socket->writev(iov, 2);
+    if (sent != ssize_t(sizeof(header) + pdu.size())) {
+      // responses are tiny, a short write means the client stopped reading
+      ESP_LOGW(TAG, "Client %" PRIu32 " write failed: errno %d", client.id, errno);
+      client.remove = true;
+    }
+    return;
+  }
+}
+
+void ModbusTCPServer::send_exception_(const ModbusTCPRequest &request, uint8_t exception_code) {
+  std::vector<uint8_t> pdu = {uint8_t(request.function_code | 0x80), exception_code};
+  this->send_response_(request.client_id, request.transaction_id, request.unit, pdu);
+}
+
+uint32_t ModbusTCPServer::ttl_for_(uint8_t unit, uint8_t function_code, uint16_t address) const {
+  for (auto &rule : this->cache_rules_) {
+    if (rule.unit == unit && rule.function_code == function_code && address >= rule.start_address &&
+        address < rule.start_address + rule.count)
+      return rule.ttl;
+  }
+  return this->cache_ttl_;
+}
+
+void ModbusTCPServer::update_cache_(const ModbusTCPRequest &request, const std::vector<uint8_t> &data) {
+  const uint32_t now = millis();
+  for (uint16_t i = 0; i < request.count && size_t(i * 2 + 1) < data.size(); i++) {
+    uint16_t address = request.start_address + i;
+    uint32_t ttl = this->ttl_for_(request.unit, request.function_code, address);
+    if (ttl == 0)
+      continue;
+    uint32_t key = cache_key_(request.unit, request.function_code, address);
+    auto it = this->cache_.find(key);
+    if (it == this->cache_.end()) {
+      if (this->cache_.size() >= this->max_cached_registers_) {
+        // make room by dropping everything that expired
+        for (auto entry = this->cache_.begin(); entry != this->cache_.end();) {
+          if (now - entry->second.timestamp > entry->second.ttl) {
+            entry = this->cache_.erase(entry);
+          } else {
+            entry++;
+          }
+        }
+        if (this->cache_.size() >= this->max_cached_registers_)
+          return;
+      }
+      it = this->cache_.emplace(key, CachedRegister{}).first;
+    }
+    it->second.value = encode_uint16(data[i * 2], data[i * 2 + 1]);
+    it->second.timestamp = now;
+    it->second.ttl = ttl;
+  }
+}
+
+void ModbusTCPServer::invalidate_cache_(uint8_t unit, uint16_t start_address, uint16_t count) {
+  // writes only affect holding registers, read with function code 3
+  const uint32_t base = cache_key_(unit, 0x03, 0);
+  // the range must not run past the last address into the keys of the next function code or unit
+  const uint32_t end = std::min<uint32_t>(uint32_t(start_address) + count, 0x10000);
+  auto first = this->cache_.lower_bound(base + start_address);
+  auto last = this->cache_.lower_bound(base + end);
+  this->cache_.erase(first, last);
+}
+
+}  // namespace modbus_tcp
+}  // namespace esphome
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/modbus/modbus.h"
+#include "esphome/components/socket/socket.h"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace modbus_tcp {
+
+/// Modbus exception codes returned by the gateway itself
+enum ModbusException : uint8_t {
+  ILLEGAL_FUNCTION = 0x01,
+  ILLEGAL_DATA_VALUE = 0x03,
+  SERVER_DEVICE_BUSY = 0x06,
+  GATEWAY_PATH_UNAVAILABLE = 0x0A,
+  GATEWAY_TARGET_NO_RESPONSE = 0x0B,
+};
+
+/// Time-to-live for cached responses of a block of registers
+struct CacheRule {
+  uint8_t unit;
+  uint8_t function_code;
+  uint16_t start_address;
+  uint16_t count;
+  uint32_t ttl;
+};
+
+struct CachedRegister {
+  uint16_t value;
+  uint32_t timestamp;
+  uint32_t ttl;
+};
+
+struct ModbusTCPClient {
+  std::unique_ptr<socket::Socket> socket;
+  std::vector<uint8_t> rx_buffer;
+  uint32_t id;
+  bool remove{false};
+};
+
+/// A request received over TCP that is waiting to be forwarded to the RTU bus
+struct ModbusTCPRequest {
+  uint32_t client_id;
+  uint16_t transaction_id;
+  uint8_t unit;
+  uint8_t function_code;
+  uint16_t start_address;
+  uint16_t count;
+  std::vector<uint8_t> payload;
+};
+
+/** Modbus TCP server forwarding requests to the devices on a Modbus RTU bus.
+ *
+ * Requests from all TCP clients are queued and sent to the RTU bus one at a time whenever the bus is idle.
+ * Register reads (function codes 3 and 4) can be answered from a cache, so clients polling the same registers
+ * repeatedly don't keep the slow serial bus busy.
+ */
+class ModbusTCPServer : public Component, public modbus::ModbusDevice {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  void on_modbus_data(const std::vector<uint8_t> &data) override;
+  void on_modbus_error(uint8_t function_code, uint8_t exception_code) override;
+  bool on_modbus_idle() override;
+
+  void set_port(uint16_t port) { this->port_ = port; }
+  void set_max_clients(uint8_t max_clients) { this->max_clients_ = max_clients; }
+  void set_max_pending_requests(uint8_t max_pending_requests) { this->max_pending_requests_ = max_pending_requests; }
+  void set_response_timeout(uint32_t response_timeout) { this->response_timeout_ = response_timeout; }
+  void set_cache_ttl(uint32_t cache_ttl) { this->cache_ttl_ = cache_ttl; }
+  void set_max_cached_registers(uint16_t max_cached_registers) { this->max_cached_registers_ = max_cached_registers; }
+  void add_cache_rule(uint8_t unit, uint8_t function_code, uint16_t start_address, uint16_t count, uint32_t ttl) {
+    this->cache_rules_.push_back({unit, function_code, start_address, count, ttl});
+  }
+
+  uint32_t get_cache_hits() const { return this->cache_hits_; }
+  uint32_t get_forwarded_requests() const { return this->forwarded_requests_; }
+
+ protected:
+  void accept_clients_();
+  void read_client_(ModbusTCPClient &client);
+  /// handle one complete MBAP frame, returns false if the frame is malformed
+  bool handle_frame_(ModbusTCPClient &client, const uint8_t *frame, size_t len);
+  bool serve_from_cache_(const ModbusTCPRequest &request);
+  /// whether a write to any of the given holding registers is queued or waiting for its response
+  bool is_write_pending_(uint8_t unit, uint16_t start_address, uint16_t count) const;
+  void send_response_(uint32_t client_id, uint16_t transaction_id, uint8_t unit, const std::vector<uint8_t> &pdu);
+  void send_exception_(const ModbusTCPRequest &request, uint8_t exception_code);
+
+  uint32_t ttl_for_(uint8_t unit, uint8_t function_code, uint16_t address) const;
+  static uint32_t cache_key_(uint8_t unit, uint8_t function_code, uint16_t address) {
+    return (uint32_t(unit) << 24) | (uint32_t(function_code) << 16) | address;
+  }
+  void update_cache_(const ModbusTCPRequest &request, const std::vector<uint8_t> &data);
+  void invalidate_cache_(uint8_t unit, uint16_t start_address, uint16_t count);
+
+  uint16_t port_{502};
+  uint8_t max_clients_{4};
+  uint8_t max_pending_requests_{16};
+  uint32_t response_timeout_{1000};
+  uint32_t cache_ttl_{0};
+  uint16_t max_cached_registers_{256};
+
+  std::unique_ptr<socket::Socket> socket_;
+  std::vector<ModbusTCPClient> clients_;
+  uint32_t next_client_id_{1};
+
+  std::deque<ModbusTCPRequest> queue_;
+  /// request that was sent to the RTU bus and is waiting for a response
+  std::unique_ptr<ModbusTCPRequest> pending_;
+  uint32_t pending_since_{0};
+
+  std::vector<CacheRule> cache_rules_;
+  std::map<uint32_t, CachedRegister> cache_;
+
+  uint32_t cache_hits_{0};
+  uint32_t forwarded_requests_{0};
+};
+
+}  // namespace modbus_tcp
+}  // namespace esphome
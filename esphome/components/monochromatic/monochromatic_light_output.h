@@ -15,10 +15,12 @@ class MonochromaticLightOutput : public light::LightOutput {
     traits.set_supported_color_modes({light::ColorMode::BRIGHTNESS});
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override { return this->output_->supports_fade(); }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float bright;
     state->current_values_as_brightness(&bright);
-    this->output_->set_level(bright);
+    this->output_->set_level(bright, length);
   }
 
  protected:
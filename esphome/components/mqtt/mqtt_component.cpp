@@ -66,92 +66,84 @@ bool MQTTComponent::send_discovery_() {
 
   ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
 
-  return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
-      [this](JsonObject root) {
-        SendDiscoveryConfig config;
-        config.state_topic = true;
-        config.command_topic = true;
-
-        this->send_discovery(root, config);
-
-        // Fields from EntityBase
-        root[MQTT_NAME] = this->friendly_name();
-        if (this->is_disabled_by_default())
-          root[MQTT_ENABLED_BY_DEFAULT] = false;
-        if (!this->get_icon().empty())
-          root[MQTT_ICON] = this->get_icon();
-
-        switch (this->get_entity()->get_entity_category()) {
-          case ENTITY_CATEGORY_NONE:
-            break;
-          case ENTITY_CATEGORY_CONFIG:
-            root[MQTT_ENTITY_CATEGORY] = "config";
-            break;
-          case ENTITY_CATEGORY_DIAGNOSTIC:
-            root[MQTT_ENTITY_CATEGORY] = "diagnostic";
-            break;
-        }
-
-        if (config.state_topic)
-          root[MQTT_STATE_TOPIC] = this->get_state_topic_();
-        if (config.command_topic)
-          root[MQTT_COMMAND_TOPIC] = this->get_command_topic_();
-        if (this->command_retain_)
-          root[MQTT_COMMAND_RETAIN] = true;
-
-        if (this->availability_ == nullptr) {
-          if (!global_mqtt_client->get_availability().topic.empty()) {
-            root[MQTT_AVAILABILITY_TOPIC] = global_mqtt_client->get_availability().topic;
-            if (global_mqtt_client->get_availability().payload_available != "online")
-              root[MQTT_PAYLOAD_AVAILABLE] = global_mqtt_client->get_availability().payload_available;
-            if (global_mqtt_client->get_availability().payload_not_available != "offline")
-              root[MQTT_PAYLOAD_NOT_AVAILABLE] = global_mqtt_client->get_availability().payload_not_available;
-          }
-        } else if (!this->availability_->topic.empty()) {
-          root[MQTT_AVAILABILITY_TOPIC] = this->availability_->topic;
-          if (this->availability_->payload_available != "online")
-            root[MQTT_PAYLOAD_AVAILABLE] = this->availability_->payload_available;
-          if (this->availability_->payload_not_available != "offline")
-            root[MQTT_PAYLOAD_NOT_AVAILABLE] = this->availability_->payload_not_available;
-        }
-
-        std::string unique_id = this->unique_id();
-        const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
-        if (!unique_id.empty()) {
-          root[MQTT_UNIQUE_ID] = unique_id;
-        } else {
-          if (discovery_info.unique_id_generator == MQTT_MAC_ADDRESS_UNIQUE_ID_GENERATOR) {
-            char friendly_name_hash[9];
-            sprintf(friendly_name_hash, "%08" PRIx32, fnv1_hash(this->friendly_name()));
-            friendly_name_hash[8] = 0;  // ensure the hash-string ends with null
-            root[MQTT_UNIQUE_ID] = get_mac_address() + "-" + this->component_type() + "-" + friendly_name_hash;
-          } else {
-            // default to almost-unique ID. It's a hack but the only way to get that
-            // gorgeous device registry view.
-            root[MQTT_UNIQUE_ID] = "ESP" + this->component_type() + this->get_default_object_id_();
-          }
-        }
-
-        const std::string &node_name = App.get_name();
-        if (discovery_info.object_id_generator == MQTT_DEVICE_NAME_OBJECT_ID_GENERATOR)
-          root[MQTT_OBJECT_ID] = node_name + "_" + this->get_default_object_id_();
-
-        std::string node_friendly_name = App.get_friendly_name();
-        if (node_friendly_name.empty()) {
-          node_friendly_name = node_name;
-        }
-        const std::string &node_area = App.get_area();
-
-        JsonObject device_info = root.createNestedObject(MQTT_DEVICE);
-        device_info[MQTT_DEVICE_IDENTIFIERS] = get_mac_address();
-        device_info[MQTT_DEVICE_NAME] = node_friendly_name;
-        device_info[MQTT_DEVICE_SW_VERSION] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
-        device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
-        device_info[MQTT_DEVICE_MANUFACTURER] = "espressif";
-        device_info[MQTT_DEVICE_SUGGESTED_AREA] = node_area;
-      },
-      0, discovery_info.retain);
+  SendDiscoveryConfig config;
+  config.state_topic = true;
+  config.command_topic = true;
+  // the entity specific fields still come from the JsonObject API, only that small part is built as a document
+  std::string entity_fields = json::build_json([this, &config](JsonObject root) { this->send_discovery(root, config); });
+
+  std::string payload = json::write_json([this, &config, &entity_fields](json::JsonWriter &root) {
+    root.merge_object(entity_fields);
+
+    // Fields from EntityBase
+    root.add(MQTT_NAME, this->friendly_name());
+    if (this->is_disabled_by_default())
+      root.add(MQTT_ENABLED_BY_DEFAULT, false);
+    if (!this->get_icon().empty())
+      root.add(MQTT_ICON, this->get_icon());
+
+    switch (this->get_entity()->get_entity_category()) {
+      case ENTITY_CATEGORY_NONE:
+        break;
+      case ENTITY_CATEGORY_CONFIG:
+        root.add(MQTT_ENTITY_CATEGORY, "config");
+        break;
+      case ENTITY_CATEGORY_DIAGNOSTIC:
+        root.add(MQTT_ENTITY_CATEGORY, "diagnostic");
+        break;
+    }
+
+    if (config.state_topic)
+      root.add(MQTT_STATE_TOPIC, this->get_state_topic_());
+    if (config.command_topic)
+      root.add(MQTT_COMMAND_TOPIC, this->get_command_topic_());
+    if (this->command_retain_)
+      root.add(MQTT_COMMAND_RETAIN, true);
+
+    const Availability &availability =
+        this->availability_ == nullptr ? global_mqtt_client->get_availability() : *this->availability_;
+    if (!availability.topic.empty()) {
+      root.add(MQTT_AVAILABILITY_TOPIC, availability.topic);
+      if (availability.payload_available != "online")
+        root.add(MQTT_PAYLOAD_AVAILABLE, availability.payload_available);
+      if (availability.payload_not_available != "offline")
+        root.add(MQTT_PAYLOAD_NOT_AVAILABLE, availability.payload_not_available);
+    }
+
+    std::string unique_id = this->unique_id();
+    const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
+    if (!unique_id.empty()) {
+      root.add(MQTT_UNIQUE_ID, unique_id);
+    } else {
+      if (discovery_info.unique_id_generator == MQTT_MAC_ADDRESS_UNIQUE_ID_GENERATOR) {
+        char friendly_name_hash[9];
+        sprintf(friendly_name_hash, "%08" PRIx32, fnv1_hash(this->friendly_name()));
+        friendly_name_hash[8] = 0;  // ensure the hash-string ends with null
+        root.add(MQTT_UNIQUE_ID, get_mac_address() + "-" + this->component_type() + "-" + friendly_name_hash);
+      } else {
+        // default to almost-unique ID. It's a hack but the only way to get that
+        // gorgeous device registry view.
+        root.add(MQTT_UNIQUE_ID, "ESP" + this->component_type() + this->get_default_object_id_());
+      }
+    }
+
+    const std::string &node_name = App.get_name();
+    if (discovery_info.object_id_generator == MQTT_DEVICE_NAME_OBJECT_ID_GENERATOR)
+      root.add(MQTT_OBJECT_ID, node_name + "_" + this->get_default_object_id_());
+
+    const std::string &node_friendly_name = App.get_friendly_name().empty() ? node_name : App.get_friendly_name();
+
+    root.begin_object(MQTT_DEVICE);
+    root.add(MQTT_DEVICE_IDENTIFIERS, get_mac_address());
+    root.add(MQTT_DEVICE_NAME, node_friendly_name);
+    root.add(MQTT_DEVICE_SW_VERSION, "esphome v" ESPHOME_VERSION " " + App.get_compilation_time());
+    root.add(MQTT_DEVICE_MODEL, ESPHOME_BOARD);
+    root.add(MQTT_DEVICE_MANUFACTURER, "espressif");
+    root.add(MQTT_DEVICE_SUGGESTED_AREA, App.get_area());
+    root.end_object();
+  });
+
+  return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), payload, 0, discovery_info.retain);
 }
 
 bool MQTTComponent::get_retain() const { return this->retain_; }
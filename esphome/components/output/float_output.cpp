@@ -21,7 +21,9 @@ void FloatOutput::set_zero_means_zero(bool zero_means_zero) { this->zero_means_z
 
 float FloatOutput::get_min_power() const { return this->min_power_; }
 
-void FloatOutput::set_level(float state) {
+void FloatOutput::set_level(float state) { this->set_level(state, 0); }
+
+void FloatOutput::set_level(float state, uint32_t length) {
   state = clamp(state, 0.0f, 1.0f);
 
 #ifdef USE_POWER_SUPPLY
@@ -37,7 +39,11 @@ void FloatOutput::set_level(float state) {
 
   if (this->is_inverted())
     state = 1.0f - state;
-  this->write_state(state);
+  if (length > 0 && this->supports_fade()) {
+    this->write_state_fade(state, length);
+  } else {
+    this->write_state(state);
+  }
 }
 
 void FloatOutput::write_state(bool state) { this->set_level(state != this->inverted_ ? 1.0f : 0.0f); }
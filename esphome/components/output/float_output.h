@@ -58,6 +58,19 @@ class FloatOutput : public BinaryOutput {
    */
   void set_level(float state);
 
+  /** Set the level of this float output, fading from the current level over the given time.
+   *
+   * Only outputs for which supports_fade() returns true ramp the level in hardware, all other outputs
+   * are set to the new level immediately.
+   *
+   * @param state The new state.
+   * @param length The length of the fade in milliseconds.
+   */
+  void set_level(float state, uint32_t length);
+
+  /// Return whether this output can fade between levels in hardware.
+  virtual bool supports_fade() const { return false; }
+
   /** Set the frequency of the output for PWM outputs.
    *
    * Implemented only by components which can set the output PWM frequency.
@@ -79,6 +92,9 @@ class FloatOutput : public BinaryOutput {
   /// Implement BinarySensor's write_enabled; this should never be called.
   void write_state(bool state) override;
   virtual void write_state(float state) = 0;
+  /// Fade to state over length milliseconds, only called if supports_fade() returns true. Any later write replaces a
+  /// fade still in progress without waiting for it to end.
+  virtual void write_state_fade(float state, uint32_t length) { this->write_state(state); }
 
   float max_power_{1.0f};
   float min_power_{0.0f};
@@ -1,55 +1,146 @@
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+#include <cinttypes>
+#include <cstring>
 
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+/// Upper bounds of the loop interval histogram buckets, in microseconds
+static const uint32_t LOOP_BUCKETS_US[] = {5000, 10000, 20000, 50000, 100000, 250000, 500000, 1000000};
+static const char *const LOOP_BUCKET_LABELS[] = {"0.005", "0.01", "0.02", "0.05", "0.1", "0.25", "0.5", "1"};
+
+// Start a row `metric{labels} `, the caller appends the value and the newline
+static void begin_row(std::string &out, const char *metric, const std::string &labels, const char *extra = "") {
+  out += metric;
+  out += '{';
+  out += labels;
+  out += extra;
+  out += "} ";
+}
+
+// Same format as Print::print(float) used to produce
+static void append_value(std::string &out, float value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.2f", value);
+  out += buf;
+}
 
+static void append_value(std::string &out, int value) {
+  char buf[12];
+  snprintf(buf, sizeof(buf), "%d", value);
+  out += buf;
+}
+
+void PrometheusHandler::setup() {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
-  for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_SENSOR, App.get_sensors());
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
-  for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_BINARY_SENSOR, App.get_binary_sensors());
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
-  for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_FAN, App.get_fans());
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
-  for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_LIGHT, App.get_lights());
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
-  for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_COVER, App.get_covers());
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
-  for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_SWITCH, App.get_switches());
 #endif
-
 #ifdef USE_LOCK
-  this->lock_type_(stream);
-  for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+  this->add_entries_(PROMETHEUS_LOCK, App.get_locks());
+#endif
+  this->setup_controller(this->include_internal_);
+
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+void PrometheusHandler::loop() {
+  for (auto &entry : this->entries_) {
+#ifdef USE_LIGHT
+    if (entry.type == PROMETHEUS_LIGHT) {
+      // lights report the current values, which change during transitions without a state callback
+      auto *light = static_cast<light::LightState *>(entry.obj);
+      if (light->current_values != light->remote_values)
+        entry.dirty = true;
+    }
 #endif
+    if (entry.dirty)
+      this->render_(entry);
+  }
+
+  const uint32_t now = micros();
+  LockGuard guard(this->lock_);
+  if (this->last_loop_ != 0) {
+    const uint32_t interval = now - this->last_loop_;
+    for (size_t i = 0; i < sizeof(LOOP_BUCKETS_US) / sizeof(LOOP_BUCKETS_US[0]); i++) {
+      if (interval <= LOOP_BUCKETS_US[i]) {
+        this->loop_buckets_[i]++;
+        break;
+      }
+    }
+    this->loop_count_++;
+    this->loop_sum_ += interval;
+  }
+  this->last_loop_ = now;
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  // The response is produced chunk by chunk as the client takes it, only one entity's rows are held at a time
+  auto cursor = std::make_shared<PrometheusResponseCursor>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4; charset=utf-8", [this, cursor](uint8_t *buffer, size_t max_len, size_t index) {
+        return this->fill_chunk_(*cursor, buffer, max_len);
+      });
+  req->send(response);
+}
+
+size_t PrometheusHandler::fill_chunk_(PrometheusResponseCursor &cursor, uint8_t *buffer, size_t max_len) {
+  size_t len = 0;
+  while (len < max_len) {
+    if (cursor.offset == cursor.piece.size() && !this->next_piece_(cursor))
+      break;
+    const size_t part = std::min(max_len - len, cursor.piece.size() - cursor.offset);
+    memcpy(buffer + len, cursor.piece.data() + cursor.offset, part);
+    cursor.offset += part;
+    len += part;
+  }
+  return len;
+}
 
-  req->send(stream);
+bool PrometheusHandler::next_piece_(PrometheusResponseCursor &cursor) {
+  cursor.offset = 0;
+  // entries are grouped by type, walk them alongside the types to put each group below its TYPE lines
+  while (cursor.type < PROMETHEUS_ENTITY_TYPE_COUNT) {
+    const char *header = type_header_(static_cast<PrometheusEntityType>(cursor.type));
+    if (header != nullptr && !cursor.header_sent) {
+      cursor.header_sent = true;
+      cursor.piece = header;
+      return true;
+    }
+    if (header != nullptr && cursor.index < this->entries_.size() && this->entries_[cursor.index].type == cursor.type) {
+      LockGuard guard(this->lock_);
+      cursor.piece = this->entries_[cursor.index++].rows;
+      return true;
+    }
+    cursor.type++;
+    cursor.header_sent = false;
+  }
+  if (cursor.histogram_sent) {
+    cursor.piece.clear();
+    return false;
+  }
+  cursor.histogram_sent = true;
+  LockGuard guard(this->lock_);
+  cursor.piece = this->loop_histogram_();
+  return true;
 }
 
 std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
@@ -62,289 +153,316 @@ std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
   return item == relabel_map_name_.end() ? obj->get_name() : item->second;
 }
 
-// Type-specific implementation
+template<typename T>
+void PrometheusHandler::add_entries_(PrometheusEntityType type, const std::vector<T *> &entities) {
+  for (T *obj : entities) {
+    if (obj->is_internal() && !this->include_internal_)
+      continue;
+    PrometheusEntry entry;
+    entry.obj = obj;
+    entry.type = type;
+    entry.labels = "id=\"" + relabel_id_(obj) + "\",name=\"" + relabel_name_(obj) + "\"";
+    this->entry_index_[obj] = this->entries_.size();
+    this->entries_.push_back(std::move(entry));
+  }
+}
+
+PrometheusEntry *PrometheusHandler::find_entry_(EntityBase *obj) {
+  auto it = this->entry_index_.find(obj);
+  return it == this->entry_index_.end() ? nullptr : &this->entries_[it->second];
+}
+
+void PrometheusHandler::mark_dirty_(EntityBase *obj) {
+  PrometheusEntry *entry = this->find_entry_(obj);
+  if (entry != nullptr)
+    entry->dirty = true;
+}
+
+const char *PrometheusHandler::type_header_(PrometheusEntityType type) {
+  switch (type) {
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+    case PROMETHEUS_SENSOR:
+      return "#TYPE esphome_sensor_value GAUGE\n"
+             "#TYPE esphome_sensor_failed GAUGE\n"
+             "#TYPE esphome_sensor_update_interval_seconds SUMMARY\n";
+#endif
+#ifdef USE_BINARY_SENSOR
+    case PROMETHEUS_BINARY_SENSOR:
+      return "#TYPE esphome_binary_sensor_value GAUGE\n"
+             "#TYPE esphome_binary_sensor_failed GAUGE\n";
+#endif
+#ifdef USE_FAN
+    case PROMETHEUS_FAN:
+      return "#TYPE esphome_fan_value GAUGE\n"
+             "#TYPE esphome_fan_failed GAUGE\n"
+             "#TYPE esphome_fan_speed GAUGE\n"
+             "#TYPE esphome_fan_oscillation GAUGE\n";
+#endif
+#ifdef USE_LIGHT
+    case PROMETHEUS_LIGHT:
+      return "#TYPE esphome_light_state GAUGE\n"
+             "#TYPE esphome_light_color GAUGE\n"
+             "#TYPE esphome_light_effect_active GAUGE\n";
+#endif
+#ifdef USE_COVER
+    case PROMETHEUS_COVER:
+      return "#TYPE esphome_cover_value GAUGE\n"
+             "#TYPE esphome_cover_failed GAUGE\n";
+#endif
+#ifdef USE_SWITCH
+    case PROMETHEUS_SWITCH:
+      return "#TYPE esphome_switch_value GAUGE\n"
+             "#TYPE esphome_switch_failed GAUGE\n";
+#endif
+#ifdef USE_LOCK
+    case PROMETHEUS_LOCK:
+      return "#TYPE esphome_lock_value GAUGE\n"
+             "#TYPE esphome_lock_failed GAUGE\n";
+#endif
+    default:
+      return nullptr;
+  }
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
+
+void PrometheusHandler::render_(PrometheusEntry &entry) {
+  // render outside of the lock, so a response being sent doesn't wait for it
+  std::string rows;
+  rows.reserve(entry.rows.size());
+  switch (entry.type) {
+#ifdef USE_SENSOR
+    case PROMETHEUS_SENSOR:
+      this->sensor_row_(rows, entry, static_cast<sensor::Sensor *>(entry.obj));
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case PROMETHEUS_BINARY_SENSOR:
+      this->binary_sensor_row_(rows, entry, static_cast<binary_sensor::BinarySensor *>(entry.obj));
+      break;
+#endif
+#ifdef USE_FAN
+    case PROMETHEUS_FAN:
+      this->fan_row_(rows, entry, static_cast<fan::Fan *>(entry.obj));
+      break;
+#endif
+#ifdef USE_LIGHT
+    case PROMETHEUS_LIGHT:
+      this->light_row_(rows, entry, static_cast<light::LightState *>(entry.obj));
+      break;
+#endif
+#ifdef USE_COVER
+    case PROMETHEUS_COVER:
+      this->cover_row_(rows, entry, static_cast<cover::Cover *>(entry.obj));
+      break;
+#endif
+#ifdef USE_SWITCH
+    case PROMETHEUS_SWITCH:
+      this->switch_row_(rows, entry, static_cast<switch_::Switch *>(entry.obj));
+      break;
+#endif
+#ifdef USE_LOCK
+    case PROMETHEUS_LOCK:
+      this->lock_row_(rows, entry, static_cast<lock::Lock *>(entry.obj));
+      break;
+#endif
+    default:
+      break;
+  }
+  entry.dirty = false;
+  LockGuard guard(this->lock_);
+  entry.rows.swap(rows);
+}
+
+std::string PrometheusHandler::loop_histogram_() {
+  std::string out = "#TYPE esphome_loop_interval_seconds HISTOGRAM\n";
+  char buf[32];
+  uint32_t cumulative = 0;
+  for (size_t i = 0; i < sizeof(LOOP_BUCKETS_US) / sizeof(LOOP_BUCKETS_US[0]); i++) {
+    cumulative += this->loop_buckets_[i];
+    out += "esphome_loop_interval_seconds_bucket{le=\"";
+    out += LOOP_BUCKET_LABELS[i];
+    out += "\"} ";
+    snprintf(buf, sizeof(buf), "%" PRIu32 "\n", cumulative);
+    out += buf;
+  }
+  snprintf(buf, sizeof(buf), "%" PRIu32 "\n", this->loop_count_);
+  out += "esphome_loop_interval_seconds_bucket{le=\"+Inf\"} ";
+  out += buf;
+  out += "esphome_loop_interval_seconds_count ";
+  out += buf;
+  snprintf(buf, sizeof(buf), "%.6f\n", this->loop_sum_ / 1e6);
+  out += "esphome_loop_interval_seconds_sum ";
+  out += buf;
+  return out;
+}
+
+// Type-specific implementation
+#ifdef USE_SENSOR
+void PrometheusHandler::on_sensor_update(sensor::Sensor *obj, float state) {
+  PrometheusEntry *entry = this->find_entry_(obj);
+  if (entry == nullptr)
     return;
+  const uint32_t now = millis();
+  if (entry->last_update != 0) {
+    entry->update_interval_sum += now - entry->last_update;
+    entry->update_count++;
+  }
+  entry->last_update = now;
+  entry->dirty = true;
+}
+void PrometheusHandler::sensor_row_(std::string &out, const PrometheusEntry &entry, sensor::Sensor *obj) {
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    begin_row(out, "esphome_sensor_failed", entry.labels);
+    out += "0\n";
     // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print(F("\n"));
+    out += "esphome_sensor_value{";
+    out += entry.labels;
+    out += ",unit=\"";
+    out += obj->get_unit_of_measurement();
+    out += "\"} ";
+    out += value_accuracy_to_string(obj->state, obj->get_accuracy_decimals());
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    begin_row(out, "esphome_sensor_failed", entry.labels);
+    out += "1\n";
   }
+  // Time between state updates
+  char buf[24];
+  begin_row(out, "esphome_sensor_update_interval_seconds_sum", entry.labels);
+  snprintf(buf, sizeof(buf), "%.3f\n", entry.update_interval_sum / 1e3);
+  out += buf;
+  begin_row(out, "esphome_sensor_update_interval_seconds_count", entry.labels);
+  snprintf(buf, sizeof(buf), "%" PRIu32 "\n", entry.update_count);
+  out += buf;
 }
 #endif
 
-// Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
-}
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, const PrometheusEntry &entry,
+                                           binary_sensor::BinarySensor *obj) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    begin_row(out, "esphome_binary_sensor_failed", entry.labels);
+    out += "0\n";
     // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print(F("\n"));
+    begin_row(out, "esphome_binary_sensor_value", entry.labels);
+    append_value(out, obj->state);
+    out += '\n';
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    begin_row(out, "esphome_binary_sensor_failed", entry.labels);
+    out += "1\n";
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
-}
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::fan_row_(std::string &out, const PrometheusEntry &entry, fan::Fan *obj) {
+  begin_row(out, "esphome_fan_failed", entry.labels);
+  out += "0\n";
   // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  begin_row(out, "esphome_fan_value", entry.labels);
+  append_value(out, obj->state);
+  out += '\n';
   // Speed if available
   if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print(F("\n"));
+    begin_row(out, "esphome_fan_speed", entry.labels);
+    append_value(out, obj->speed);
+    out += '\n';
   }
   // Oscillation if available
   if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print(F("\n"));
+    begin_row(out, "esphome_fan_oscillation", entry.labels);
+    append_value(out, obj->oscillating);
+    out += '\n';
   }
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
-}
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::light_row_(std::string &out, const PrometheusEntry &entry, light::LightState *obj) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  begin_row(out, "esphome_light_state", entry.labels);
+  append_value(out, obj->remote_values.is_on());
+  out += '\n';
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  begin_row(out, "esphome_light_color", entry.labels, ",channel=\"brightness\"");
+  append_value(out, brightness);
+  out += '\n';
+  begin_row(out, "esphome_light_color", entry.labels, ",channel=\"r\"");
+  append_value(out, r);
+  out += '\n';
+  begin_row(out, "esphome_light_color", entry.labels, ",channel=\"g\"");
+  append_value(out, g);
+  out += '\n';
+  begin_row(out, "esphome_light_color", entry.labels, ",channel=\"b\"");
+  append_value(out, b);
+  out += '\n';
+  begin_row(out, "esphome_light_color", entry.labels, ",channel=\"w\"");
+  append_value(out, w);
+  out += '\n';
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    begin_row(out, "esphome_light_effect_active", entry.labels, ",effect=\"None\"");
+    out += "0\n";
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    out += "esphome_light_effect_active{";
+    out += entry.labels;
+    out += ",effect=\"";
+    out += effect;
+    out += "\"} 1\n";
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
-}
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
+void PrometheusHandler::cover_row_(std::string &out, const PrometheusEntry &entry, cover::Cover *obj) {
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
+    begin_row(out, "esphome_cover_failed", entry.labels);
+    out += "0\n";
     // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print(F("\n"));
+    begin_row(out, "esphome_cover_value", entry.labels);
+    append_value(out, obj->position);
+    out += '\n';
     if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print(F("\n"));
+      begin_row(out, "esphome_cover_tilt", entry.labels);
+      append_value(out, obj->tilt);
+      out += '\n';
     }
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    begin_row(out, "esphome_cover_failed", entry.labels);
+    out += "1\n";
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
-}
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::switch_row_(std::string &out, const PrometheusEntry &entry, switch_::Switch *obj) {
+  begin_row(out, "esphome_switch_failed", entry.labels);
+  out += "0\n";
   // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  begin_row(out, "esphome_switch_value", entry.labels);
+  append_value(out, obj->state);
+  out += '\n';
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_lock_failed GAUGE\n"));
-}
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
+void PrometheusHandler::lock_row_(std::string &out, const PrometheusEntry &entry, lock::Lock *obj) {
+  begin_row(out, "esphome_lock_failed", entry.labels);
+  out += "0\n";
   // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+  begin_row(out, "esphome_lock_value", entry.labels);
+  append_value(out, obj->state);
+  out += '\n';
 }
 #endif
 
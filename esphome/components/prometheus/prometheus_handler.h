@@ -1,17 +1,61 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/entity_base.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 namespace prometheus {
 
-class PrometheusHandler : public AsyncWebHandler, public Component {
+enum PrometheusEntityType : uint8_t {
+  PROMETHEUS_SENSOR,
+  PROMETHEUS_BINARY_SENSOR,
+  PROMETHEUS_FAN,
+  PROMETHEUS_LIGHT,
+  PROMETHEUS_COVER,
+  PROMETHEUS_SWITCH,
+  PROMETHEUS_LOCK,
+  PROMETHEUS_ENTITY_TYPE_COUNT,
+};
+
+/// The cached exposition lines of one entity, rendered on the main loop
+struct PrometheusEntry {
+  EntityBase *obj;
+  PrometheusEntityType type;
+  /// whether the state changed since the rows were rendered
+  bool dirty{true};
+  /// the id and name labels, they don't change at runtime
+  std::string labels;
+  std::string rows;
+  /// time of the last state update in milliseconds, used for the sensor update interval summary
+  uint32_t last_update{0};
+  uint32_t update_count{0};
+  uint64_t update_interval_sum{0};
+};
+
+/// Position of a /metrics response that is produced while the client takes the chunks
+struct PrometheusResponseCursor {
+  /// the entity type whose rows are sent, PROMETHEUS_ENTITY_TYPE_COUNT for the histogram at the end
+  uint8_t type{0};
+  bool header_sent{false};
+  bool histogram_sent{false};
+  /// the next entry to send
+  size_t index{0};
+  /// copy of the piece that is being sent, so rendering the cache again doesn't change it midway
+  std::string piece;
+  size_t offset{0};
+};
+
+class PrometheusHandler : public AsyncWebHandler, public Component, public Controller {
  public:
   PrometheusHandler(web_server_base::WebServerBase *base) : base_(base) {}
 
@@ -47,72 +91,107 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
+  void loop() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
 
+#ifdef USE_SENSOR
+  void on_sensor_update(sensor::Sensor *obj, float state) override;
+#endif
+#ifdef USE_BINARY_SENSOR
+  void on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) override { this->mark_dirty_(obj); }
+#endif
+#ifdef USE_FAN
+  void on_fan_update(fan::Fan *obj) override { this->mark_dirty_(obj); }
+#endif
+#ifdef USE_LIGHT
+  void on_light_update(light::LightState *obj) override { this->mark_dirty_(obj); }
+#endif
+#ifdef USE_COVER
+  void on_cover_update(cover::Cover *obj) override { this->mark_dirty_(obj); }
+#endif
+#ifdef USE_SWITCH
+  void on_switch_update(switch_::Switch *obj, bool state) override { this->mark_dirty_(obj); }
+#endif
+#ifdef USE_LOCK
+  void on_lock_update(lock::Lock *obj) override { this->mark_dirty_(obj); }
+#endif
+
  protected:
   std::string relabel_id_(EntityBase *obj);
   std::string relabel_name_(EntityBase *obj);
 
+  template<typename T> void add_entries_(PrometheusEntityType type, const std::vector<T *> &entities);
+  PrometheusEntry *find_entry_(EntityBase *obj);
+  void mark_dirty_(EntityBase *obj);
+  /// Return the TYPE lines of an entity type, or nullptr if the type isn't compiled in
+  static const char *type_header_(PrometheusEntityType type);
+  /// Render the rows of an entity into its cache, only called from the main loop
+  void render_(PrometheusEntry &entry);
+  std::string loop_histogram_();
+  /// Fill a chunk of the /metrics response, returns 0 once the response is complete
+  size_t fill_chunk_(PrometheusResponseCursor &cursor, uint8_t *buffer, size_t max_len);
+  /// Move the cursor to the next piece of the response, returns false at the end
+  bool next_piece_(PrometheusResponseCursor &cursor);
+
 #ifdef USE_SENSOR
-  /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
+  void sensor_row_(std::string &out, const PrometheusEntry &entry, sensor::Sensor *obj);
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
+  void binary_sensor_row_(std::string &out, const PrometheusEntry &entry, binary_sensor::BinarySensor *obj);
 #endif
 
 #ifdef USE_FAN
-  /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj);
+  void fan_row_(std::string &out, const PrometheusEntry &entry, fan::Fan *obj);
 #endif
 
 #ifdef USE_LIGHT
-  /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
+  void light_row_(std::string &out, const PrometheusEntry &entry, light::LightState *obj);
 #endif
 
 #ifdef USE_COVER
-  /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
+  void cover_row_(std::string &out, const PrometheusEntry &entry, cover::Cover *obj);
 #endif
 
 #ifdef USE_SWITCH
-  /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
+  void switch_row_(std::string &out, const PrometheusEntry &entry, switch_::Switch *obj);
 #endif
 
 #ifdef USE_LOCK
-  /// Return the type for prometheus
-  void lock_type_(AsyncResponseStream *stream);
   /// Return the lock Values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
+  void lock_row_(std::string &out, const PrometheusEntry &entry, lock::Lock *obj);
 #endif
 
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
   std::map<EntityBase *, std::string> relabel_map_name_;
+
+  /// cached rows of all exported entities, grouped by entity type in exposition order
+  std::vector<PrometheusEntry> entries_;
+  std::unordered_map<EntityBase *, size_t> entry_index_;
+
+  /** Guards the rows in entries_ and the loop histogram.
+   *
+   * The response is produced on the web server task, which only copies the rows the main loop rendered.
+   */
+  Mutex lock_;
+
+  /// histogram of the time between two main loop iterations
+  uint32_t last_loop_{0};
+  uint32_t loop_buckets_[8]{};
+  uint32_t loop_count_{0};
+  uint64_t loop_sum_{0};
 };
 
 }  // namespace prometheus
@@ -18,12 +18,16 @@ class RGBLightOutput : public light::LightOutput {
     traits.set_supported_color_modes({light::ColorMode::RGB});
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override {
+    return this->red_->supports_fade() && this->green_->supports_fade() && this->blue_->supports_fade();
+  }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float red, green, blue;
     state->current_values_as_rgb(&red, &green, &blue, false);
-    this->red_->set_level(red);
-    this->green_->set_level(green);
-    this->blue_->set_level(blue);
+    this->red_->set_level(red, length);
+    this->green_->set_level(green, length);
+    this->blue_->set_level(blue, length);
   }
 
  protected:
@@ -31,16 +31,21 @@ class RGBCTLightOutput : public light::LightOutput {
     traits.set_max_mireds(this->warm_white_temperature_);
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override {
+    return this->red_->supports_fade() && this->green_->supports_fade() && this->blue_->supports_fade() &&
+           this->color_temperature_->supports_fade() && this->white_brightness_->supports_fade();
+  }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float red, green, blue, color_temperature, white_brightness;
 
     state->current_values_as_rgbct(&red, &green, &blue, &color_temperature, &white_brightness);
 
-    this->red_->set_level(red);
-    this->green_->set_level(green);
-    this->blue_->set_level(blue);
-    this->color_temperature_->set_level(color_temperature);
-    this->white_brightness_->set_level(white_brightness);
+    this->red_->set_level(red, length);
+    this->green_->set_level(green, length);
+    this->blue_->set_level(blue, length);
+    this->color_temperature_->set_level(color_temperature, length);
+    this->white_brightness_->set_level(white_brightness, length);
   }
 
  protected:
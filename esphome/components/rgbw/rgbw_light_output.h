@@ -22,13 +22,18 @@ class RGBWLightOutput : public light::LightOutput {
       traits.set_supported_color_modes({light::ColorMode::RGB_WHITE});
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override {
+    return this->red_->supports_fade() && this->green_->supports_fade() && this->blue_->supports_fade() &&
+           this->white_->supports_fade();
+  }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float red, green, blue, white;
     state->current_values_as_rgbw(&red, &green, &blue, &white, this->color_interlock_);
-    this->red_->set_level(red);
-    this->green_->set_level(green);
-    this->blue_->set_level(blue);
-    this->white_->set_level(white);
+    this->red_->set_level(red, length);
+    this->green_->set_level(green, length);
+    this->blue_->set_level(blue, length);
+    this->white_->set_level(white, length);
   }
 
  protected:
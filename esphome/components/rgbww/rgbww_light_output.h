@@ -28,14 +28,19 @@ class RGBWWLightOutput : public light::LightOutput {
     traits.set_max_mireds(this->warm_white_temperature_);
     return traits;
   }
-  void write_state(light::LightState *state) override {
+  bool supports_fade() override {
+    return this->red_->supports_fade() && this->green_->supports_fade() && this->blue_->supports_fade() &&
+           this->cold_white_->supports_fade() && this->warm_white_->supports_fade();
+  }
+  void write_state(light::LightState *state) override { this->write_state_fade(state, 0); }
+  void write_state_fade(light::LightState *state, uint32_t length) override {
     float red, green, blue, cwhite, wwhite;
     state->current_values_as_rgbww(&red, &green, &blue, &cwhite, &wwhite, this->constant_brightness_);
-    this->red_->set_level(red);
-    this->green_->set_level(green);
-    this->blue_->set_level(blue);
-    this->cold_white_->set_level(cwhite);
-    this->warm_white_->set_level(wwhite);
+    this->red_->set_level(red, length);
+    this->green_->set_level(green, length);
+    this->blue_->set_level(blue, length);
+    this->cold_white_->set_level(cwhite, length);
+    this->warm_white_->set_level(wwhite, length);
   }
 
  protected:
@@ -222,6 +222,14 @@ class SPIDelegate {
       this->transfer(ptr[i]);
   }
 
+  // start writing a buffer without waiting for the transfer to complete. Only the buffer passed to the latest call
+  // may still be in use when this returns, so a caller can fill one buffer while the other one is on the wire.
+  // Delegates without background transfers write synchronously.
+  virtual void queue_write_array(const uint8_t *ptr, size_t length) { this->write_array(ptr, length); }
+
+  // wait until all queued writes have completed
+  virtual void wait_queued_writes() {}
+
   // read into a buffer, write nulls
   virtual void read_array(uint8_t *ptr, size_t length) {
     for (size_t i = 0; i != length; i++)
@@ -426,6 +434,11 @@ class SPIDevice : public SPIClient {
 
   void write_array(const uint8_t *data, size_t length) { this->delegate_->write_array(data, length); }
 
+  // see SPIDelegate::queue_write_array(). Queued writes are completed before the transaction ends.
+  void queue_write_array(const uint8_t *data, size_t length) { this->delegate_->queue_write_array(data, length); }
+
+  void wait_queued_writes() { this->delegate_->wait_queued_writes(); }
+
   template<size_t N> void write_array(const std::array<uint8_t, N> &data) { this->write_array(data.data(), N); }
 
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
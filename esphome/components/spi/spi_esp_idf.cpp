@@ -7,6 +7,7 @@ namespace spi {
 #ifdef USE_ESP_IDF
 static const char *const TAG = "spi-esp-idf";
 static const size_t MAX_TRANSFER_SIZE = 4092;  // dictated by ESP-IDF API.
+static const size_t QUEUE_DEPTH = 4;           // transactions that can be queued for background (DMA) transfer
 
 class SPIDelegateHw : public SPIDelegate {
  public:
@@ -18,7 +19,7 @@ class SPIDelegateHw : public SPIDelegate {
     config.clock_speed_hz = static_cast<int>(data_rate);
     config.spics_io_num = -1;
     config.flags = 0;
-    config.queue_size = 1;
+    config.queue_size = QUEUE_DEPTH;
     config.pre_cb = nullptr;
     config.post_cb = nullptr;
     if (bit_order == BIT_ORDER_LSB_FIRST)
@@ -44,12 +45,14 @@ class SPIDelegateHw : public SPIDelegate {
 
   void end_transaction() override {
     if (this->is_ready()) {
+      this->wait_queued_writes();
       SPIDelegate::end_transaction();
       spi_device_release_bus(this->handle_);
     }
   }
 
   ~SPIDelegateHw() override {
+    this->wait_queued_writes();
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -57,13 +60,13 @@ class SPIDelegateHw : public SPIDelegate {
 
   // do a transfer. either txbuf or rxbuf (but not both) may be null.
   // transfers above the maximum size will be split.
-  // TODO - make use of the queue for interrupt transfers to provide a (short) pipeline of blocks
-  // when splitting is required.
   void transfer(const uint8_t *txbuf, uint8_t *rxbuf, size_t length) override {
     if (rxbuf != nullptr && this->write_only_) {
       ESP_LOGE(TAG, "Attempted read from write-only channel");
       return;
     }
+    // polling transfers can't be mixed with transactions still in the queue
+    this->wait_queued_writes();
     spi_transaction_t desc = {};
     desc.flags = 0;
     while (length != 0) {
@@ -122,7 +125,47 @@ class SPIDelegateHw : public SPIDelegate {
 
   void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
 
+  // queue the buffer for DMA transfer, splitting it into blocks the driver pipelines back to back.
+  void queue_write_array(const uint8_t *ptr, size_t length) override {
+    // the buffers of earlier calls must be free when this returns
+    this->wait_queued_writes();
+    while (length != 0) {
+      if (this->queued_count_ == QUEUE_DEPTH)
+        this->wait_queued_(1);
+      size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+      spi_transaction_t &desc = this->queued_[this->queued_next_];
+      desc = {};
+      desc.length = partial * 8;
+      desc.tx_buffer = ptr;
+      esp_err_t const err = spi_device_queue_trans(this->handle_, &desc, portMAX_DELAY);
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Queue transfer failed - err %X", err);
+        break;
+      }
+      this->queued_next_ = (this->queued_next_ + 1) % QUEUE_DEPTH;
+      this->queued_count_++;
+      length -= partial;
+      ptr += partial;
+    }
+  }
+
+  void wait_queued_writes() override { this->wait_queued_(this->queued_count_); }
+
  protected:
+  // collect the results of the given number of queued transactions, oldest first
+  void wait_queued_(size_t count) {
+    while (count-- != 0) {
+      spi_transaction_t *done;
+      esp_err_t const err = spi_device_get_trans_result(this->handle_, &done, portMAX_DELAY);
+      if (err != ESP_OK)
+        ESP_LOGE(TAG, "Queued transfer failed - err %X", err);
+      this->queued_count_--;
+    }
+  }
+
+  spi_transaction_t queued_[QUEUE_DEPTH]{};
+  size_t queued_next_{0};
+  size_t queued_count_{0};
   SPIInterface channel_{};
   spi_device_handle_t handle_{};
   bool write_only_{false};
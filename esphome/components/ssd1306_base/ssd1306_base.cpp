@@ -2,6 +2,8 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace ssd1306_base {
 
@@ -284,6 +286,29 @@ void HOT SSD1306::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] &= ~(1 << subpos);
   }
 }
+void HOT SSD1306::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const int x2 = std::min(x + width, this->get_width_internal());
+  const int y2 = std::min(y + height, this->get_height_internal());
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (x >= x2 || y >= y2)
+    return;
+
+  // Each byte holds a column of 8 pixels, so the rectangle is drawn a page of 8 rows at a time
+  for (int page_y = y & ~0x07; page_y < y2; page_y += 8) {
+    const int first = std::max(y, page_y) - page_y;
+    const int last = std::min(y2, page_y + 8) - page_y;
+    const uint8_t mask = (0xFF << first) & (0xFF >> (8 - last));
+    uint8_t *pos = this->buffer_ + x + (page_y / 8) * this->get_width_internal();
+    for (int i = x; i < x2; i++, pos++) {
+      if (color.is_on()) {
+        *pos |= mask;
+      } else {
+        *pos &= ~mask;
+      }
+    }
+  }
+}
 void SSD1306::fill(Color color) {
   uint8_t fill = color.is_on() ? 0xFF : 0x00;
   for (uint32_t i = 0; i < this->get_buffer_length_(); i++)
@@ -1,6 +1,9 @@
 #include "st7789v.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace esphome {
 namespace st7789v {
 
@@ -305,5 +308,52 @@ void HOT ST7789V::draw_absolute_pixel_internal(int x, int y, Color color) {
   }
 }
 
+void HOT ST7789V::fill_absolute_rect_internal(int x, int y, int width, int height, Color color) {
+  const int x2 = std::min(x + width, this->get_width_internal());
+  const int y2 = std::min(y + height, this->get_height_internal());
+  x = std::max(x, 0);
+  y = std::max(y, 0);
+  if (x >= x2 || y >= y2)
+    return;
+
+  if (this->eightbitcolor_) {
+    const uint8_t color332 = display::ColorUtil::color_to_332(color);
+    for (int row = y; row < y2; row++)
+      memset(this->buffer_ + row * this->get_width_internal() + x, color332, x2 - x);
+  } else {
+    const uint16_t color565 = display::ColorUtil::color_to_565(color);
+    const uint8_t high = color565 >> 8, low = color565 & 0xff;
+    for (int row = y; row < y2; row++) {
+      uint8_t *pos = this->buffer_ + (row * this->get_width_internal() + x) * 2;
+      for (int i = x; i < x2; i++) {
+        *pos++ = high;
+        *pos++ = low;
+      }
+    }
+  }
+}
+
+void HOT ST7789V::draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) {
+  const int end_x = x + dx * (len - 1);
+  const int end_y = y + dy * (len - 1);
+  if (std::min(x, end_x) < 0 || std::max(x, end_x) >= this->get_width_internal() || std::min(y, end_y) < 0 ||
+      std::max(y, end_y) >= this->get_height_internal()) {
+    display::DisplayBuffer::draw_absolute_span_internal(x, y, dx, dy, colors, len);
+    return;
+  }
+
+  const int step = dy * this->get_width_internal() + dx;
+  uint32_t pos = x + y * this->get_width_internal();
+  for (int i = 0; i < len; i++, pos += step) {
+    if (this->eightbitcolor_) {
+      this->buffer_[pos] = display::ColorUtil::color_to_332(colors[i]);
+    } else {
+      const uint16_t color565 = display::ColorUtil::color_to_565(colors[i]);
+      this->buffer_[pos * 2] = color565 >> 8;
+      this->buffer_[pos * 2 + 1] = color565 & 0xff;
+    }
+  }
+}
+
 }  // namespace st7789v
 }  // namespace esphome
@@ -165,6 +165,8 @@ class ST7789V : public PollingComponent,
   void draw_filled_rect_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 
   void draw_absolute_pixel_internal(int x, int y, Color color) override;
+  void fill_absolute_rect_internal(int x, int y, int width, int height, Color color) override;
+  void draw_absolute_span_internal(int x, int y, int dx, int dy, const Color *colors, int len) override;
 
   const char *model_str_;
 };
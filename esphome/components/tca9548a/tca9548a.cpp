@@ -6,7 +6,14 @@ namespace tca9548a {
 
 static const char *const TAG = "tca9548a";
 
+void TCA9548AChannel::set_parent(TCA9548AComponent *parent) {
+  this->parent_ = parent;
+  parent->channels_.push_back(this);
+}
+
 i2c::ErrorCode TCA9548AChannel::readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) {
+  // the channel stays selected for the transfer only if nothing else uses the upstream bus in between
+  LockGuard guard(this->parent_->bus_->get_lock());
   auto err = this->parent_->switch_to_channel(channel_);
   if (err != i2c::ERROR_OK)
     return err;
@@ -15,6 +22,8 @@ i2c::ErrorCode TCA9548AChannel::readv(uint8_t address, i2c::ReadBuffer *buffers,
   return err;
 }
 i2c::ErrorCode TCA9548AChannel::writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt, bool stop) {
+  // the channel stays selected for the transfer only if nothing else uses the upstream bus in between
+  LockGuard guard(this->parent_->bus_->get_lock());
   auto err = this->parent_->switch_to_channel(channel_);
   if (err != i2c::ERROR_OK)
     return err;
@@ -38,16 +47,22 @@ void TCA9548AComponent::dump_config() {
   LOG_I2C_DEVICE(this);
 }
 
+void TCA9548AComponent::loop() {
+  for (auto *channel : this->channels_)
+    channel->process_transactions();
+}
+
 i2c::ErrorCode TCA9548AComponent::switch_to_channel(uint8_t channel) {
   if (this->is_failed())
     return i2c::ERROR_NOT_INITIALIZED;
 
   uint8_t channel_val = 1 << channel;
-  return this->write(&channel_val, 1);
+  // called with the lock of the upstream bus held
+  return this->bus_->write(this->address_, &channel_val, 1);
 }
 
 void TCA9548AComponent::disable_all_channels() {
-  if (this->write(&TCA9548A_DISABLE_CHANNELS_COMMAND, 1) != i2c::ERROR_OK) {
+  if (this->bus_->write(this->address_, &TCA9548A_DISABLE_CHANNELS_COMMAND, 1) != i2c::ERROR_OK) {
     ESP_LOGE(TAG, "Failed to disable all channels.");
     this->status_set_error();  // couldn't disable channels, set error status
   }
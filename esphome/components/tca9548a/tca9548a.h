@@ -3,6 +3,8 @@
 #include "esphome/core/component.h"
 #include "esphome/components/i2c/i2c.h"
 
+#include <vector>
+
 namespace esphome {
 namespace tca9548a {
 
@@ -12,11 +14,17 @@ class TCA9548AComponent;
 class TCA9548AChannel : public i2c::I2CBus {
  public:
   void set_channel(uint8_t channel) { channel_ = channel; }
-  void set_parent(TCA9548AComponent *parent) { parent_ = parent; }
+  void set_parent(TCA9548AComponent *parent);
 
   i2c::ErrorCode readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) override;
   i2c::ErrorCode writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt, bool stop) override;
 
+  /// Run the queued transactions of devices on this channel, called from the multiplexer's loop
+  void process_transactions() {
+    this->run_transactions_();
+    this->complete_transactions_();
+  }
+
  protected:
   uint8_t channel_;
   TCA9548AComponent *parent_;
@@ -26,6 +34,7 @@ class TCA9548AComponent : public Component, public i2c::I2CDevice {
  public:
   void setup() override;
   void dump_config() override;
+  void loop() override;
   float get_setup_priority() const override { return setup_priority::IO; }
   void update();
 
@@ -34,6 +43,7 @@ class TCA9548AComponent : public Component, public i2c::I2CDevice {
 
  protected:
   friend class TCA9548AChannel;
+  std::vector<TCA9548AChannel *> channels_;
 };
 }  // namespace tca9548a
 }  // namespace esphome
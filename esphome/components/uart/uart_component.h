@@ -43,6 +43,9 @@ class UARTComponent {
   bool read_byte(uint8_t *data) { return this->read_array(data, 1); };
   virtual bool peek_byte(uint8_t *data) = 0;
   virtual bool read_array(uint8_t *data, size_t len) = 0;
+  /// Read up to max_len bytes that have already been received, without waiting for more.
+  /// Returns the number of bytes copied into data.
+  virtual size_t read_available(uint8_t *data, size_t max_len);
 
   /// Return available number of bytes.
   virtual int available() = 0;
@@ -67,11 +70,24 @@ class UARTComponent {
   void add_debug_callback(std::function<void(UARTDirection, uint8_t)> &&callback) {
     this->debug_callback_.add(std::move(callback));
   }
+  /// Add a callback that is called once for every block of bytes written to or read from the bus.
+  void add_debug_frame_callback(std::function<void(UARTDirection, const uint8_t *, size_t)> &&callback) {
+    this->debug_frame_callback_.add(std::move(callback));
+  }
 #endif
 
  protected:
   virtual void check_logger_conflict() = 0;
   bool check_read_timeout_(size_t len = 1);
+#ifdef USE_UART_DEBUGGER
+  void debug_frame_(UARTDirection direction, const uint8_t *data, size_t len) {
+    this->debug_frame_callback_.call(direction, data, len);
+    if (this->debug_callback_.size() == 0)
+      return;
+    for (size_t i = 0; i < len; i++)
+      this->debug_callback_.call(direction, data[i]);
+  }
+#endif
 
   InternalGPIOPin *tx_pin_;
   InternalGPIOPin *rx_pin_;
@@ -82,6 +98,7 @@ class UARTComponent {
   UARTParityOptions parity_;
 #ifdef USE_UART_DEBUGGER
   CallbackManager<void(UARTDirection, uint8_t)> debug_callback_{};
+  CallbackManager<void(UARTDirection, const uint8_t *, size_t)> debug_frame_callback_{};
 #endif
 };
 
@@ -137,9 +137,7 @@ void ESP32ArduinoUARTComponent::dump_config() {
 void ESP32ArduinoUARTComponent::write_array(const uint8_t *data, size_t len) {
   this->hw_serial_->write(data, len);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_TX, data, len);
 #endif
 }
 
@@ -155,9 +153,7 @@ bool ESP32ArduinoUARTComponent::read_array(uint8_t *data, size_t len) {
     return false;
   this->hw_serial_->readBytes(data, len);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_RX, data, len);
 #endif
   return true;
 }
@@ -5,6 +5,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
+#include <algorithm>
 #include <cinttypes>
 
 #ifdef USE_LOGGER
@@ -142,9 +143,7 @@ void IDFUARTComponent::write_array(const uint8_t *data, size_t len) {
   uart_write_bytes(this->uart_num_, data, len);
   xSemaphoreGive(this->lock_);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_TX, data, len);
 #endif
 }
 
@@ -172,23 +171,47 @@ bool IDFUARTComponent::read_array(uint8_t *data, size_t len) {
   if (!this->check_read_timeout_(len))
     return false;
   xSemaphoreTake(this->lock_, portMAX_DELAY);
+  uint8_t *dest = data;
   if (this->has_peek_) {
     length_to_read--;
-    *data = this->peek_byte_;
-    data++;
+    *dest = this->peek_byte_;
+    dest++;
     this->has_peek_ = false;
   }
   if (length_to_read > 0)
-    uart_read_bytes(this->uart_num_, data, length_to_read, 20 / portTICK_PERIOD_MS);
+    uart_read_bytes(this->uart_num_, dest, length_to_read, 20 / portTICK_PERIOD_MS);
   xSemaphoreGive(this->lock_);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_RX, data, len);
 #endif
   return true;
 }
 
+size_t IDFUARTComponent::read_available(uint8_t *data, size_t max_len) {
+  if (max_len == 0)
+    return 0;
+  size_t len = 0;
+  xSemaphoreTake(this->lock_, portMAX_DELAY);
+  if (this->has_peek_) {
+    data[len++] = this->peek_byte_;
+    this->has_peek_ = false;
+  }
+  size_t buffered;
+  uart_get_buffered_data_len(this->uart_num_, &buffered);
+  size_t to_read = std::min(buffered, max_len - len);
+  if (to_read > 0) {
+    // Everything requested is already in the driver's ring buffer, so don't wait for more.
+    int read = uart_read_bytes(this->uart_num_, data + len, to_read, 0);
+    if (read > 0)
+      len += read;
+  }
+  xSemaphoreGive(this->lock_);
+#ifdef USE_UART_DEBUGGER
+  this->debug_frame_(UART_DIRECTION_RX, data, len);
+#endif
+  return len;
+}
+
 int IDFUARTComponent::available() {
   size_t available;
 
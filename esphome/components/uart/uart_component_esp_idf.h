@@ -19,6 +19,7 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   bool peek_byte(uint8_t *data) override;
   bool read_array(uint8_t *data, size_t len) override;
+  size_t read_available(uint8_t *data, size_t max_len) override;
 
   int available() override;
   void flush() override;
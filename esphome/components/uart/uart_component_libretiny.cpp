@@ -118,9 +118,7 @@ void LibreTinyUARTComponent::dump_config() {
 void LibreTinyUARTComponent::write_array(const uint8_t *data, size_t len) {
   this->serial_->write(data, len);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_TX, data, len);
 #endif
 }
 
@@ -136,9 +134,7 @@ bool LibreTinyUARTComponent::read_array(uint8_t *data, size_t len) {
     return false;
   this->serial_->readBytes(data, len);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_RX, data, len);
 #endif
   return true;
 }
@@ -150,9 +150,7 @@ void RP2040UartComponent::dump_config() {
 void RP2040UartComponent::write_array(const uint8_t *data, size_t len) {
   this->serial_->write(data, len);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_TX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_TX, data, len);
 #endif
 }
 bool RP2040UartComponent::peek_byte(uint8_t *data) {
@@ -166,9 +164,7 @@ bool RP2040UartComponent::read_array(uint8_t *data, size_t len) {
     return false;
   this->serial_->readBytes(data, len);
 #ifdef USE_UART_DEBUGGER
-  for (size_t i = 0; i < len; i++) {
-    this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
-  }
+  this->debug_frame_(UART_DIRECTION_RX, data, len);
 #endif
   return true;
 }
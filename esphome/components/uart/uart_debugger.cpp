@@ -12,14 +12,16 @@ namespace uart {
 static const char *const TAG = "uart_debug";
 
 UARTDebugger::UARTDebugger(UARTComponent *parent) {
-  parent->add_debug_callback([this](UARTDirection direction, uint8_t byte) {
+  parent->add_debug_frame_callback([this](UARTDirection direction, const uint8_t *data, size_t len) {
     if (!this->is_my_direction_(direction) || this->is_recursive_()) {
       return;
     }
     this->trigger_after_direction_change_(direction);
-    this->store_byte_(direction, byte);
-    this->trigger_after_delimiter_(byte);
-    this->trigger_after_bytes_();
+    for (size_t i = 0; i < len; i++) {
+      this->store_byte_(direction, data[i]);
+      this->trigger_after_delimiter_(data[i]);
+      this->trigger_after_bytes_();
+    }
   });
 }
 
@@ -83,11 +85,8 @@ void UARTDebugger::fire_trigger_() {
 void UARTDummyReceiver::loop() {
   // Reading up to a limited number of bytes, to make sure that this loop()
   // won't lock up the system on a continuous incoming stream of bytes.
-  uint8_t data;
-  int count = 50;
-  while (this->available() && count--) {
-    this->read_byte(&data);
-  }
+  uint8_t data[50];
+  this->read_available(data, sizeof(data));
 }
 
 // In the upcoming log functions, a delay was added after all log calls.
@@ -34,6 +34,12 @@ CONF_NOISE_SUPPRESSION_LEVEL = "noise_suppression_level"
 CONF_AUTO_GAIN = "auto_gain"
 CONF_VOLUME_MULTIPLIER = "volume_multiplier"
 
+CONF_AUDIO_PROCESSING = "audio_processing"
+CONF_HIGH_PASS_FREQUENCY = "high_pass_frequency"
+CONF_TARGET_LEVEL = "target_level"
+CONF_MAX_GAIN = "max_gain"
+CONF_VOICE_ACTIVITY_DETECTION = "voice_activity_detection"
+
 
 voice_assistant_ns = cg.esphome_ns.namespace("voice_assistant")
 VoiceAssistant = voice_assistant_ns.class_("VoiceAssistant", cg.Component)
@@ -51,6 +57,22 @@ IsRunningCondition = voice_assistant_ns.class_(
     "IsRunningCondition", automation.Condition, cg.Parented.template(VoiceAssistant)
 )
 
+AUDIO_PROCESSING_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_HIGH_PASS_FREQUENCY): cv.All(
+            cv.frequency, cv.float_range(min=10, max=1000)
+        ),
+        cv.Optional(CONF_TARGET_LEVEL): cv.All(
+            cv.float_with_unit("decibel full scale", "(dBFS|dbfs|DBFS)"),
+            cv.float_range(min=-40, max=0),
+        ),
+        cv.Optional(CONF_MAX_GAIN, default="24dB"): cv.All(
+            cv.decibel, cv.float_range(min=0, max=40)
+        ),
+        cv.Optional(CONF_VOICE_ACTIVITY_DETECTION, default=False): cv.boolean,
+    }
+)
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -72,6 +94,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_VOLUME_MULTIPLIER, default=1.0): cv.float_range(
                 min=0.0, min_included=False
             ),
+            cv.Optional(CONF_AUDIO_PROCESSING): AUDIO_PROCESSING_SCHEMA,
             cv.Optional(CONF_ON_LISTENING): automation.validate_automation(single=True),
             cv.Optional(CONF_ON_START): automation.validate_automation(single=True),
             cv.Optional(CONF_ON_WAKE_WORD_DETECTED): automation.validate_automation(
@@ -117,6 +140,21 @@ async def to_code(config):
     cg.add(var.set_auto_gain(config[CONF_AUTO_GAIN]))
     cg.add(var.set_volume_multiplier(config[CONF_VOLUME_MULTIPLIER]))
 
+    if processing := config.get(CONF_AUDIO_PROCESSING):
+        if CONF_HIGH_PASS_FREQUENCY in processing:
+            cg.add(var.set_high_pass_frequency(processing[CONF_HIGH_PASS_FREQUENCY]))
+        if CONF_TARGET_LEVEL in processing:
+            cg.add(
+                var.set_auto_gain_control(
+                    processing[CONF_TARGET_LEVEL], processing[CONF_MAX_GAIN]
+                )
+            )
+        cg.add(
+            var.set_voice_activity_detection(
+                processing[CONF_VOICE_ACTIVITY_DETECTION]
+            )
+        )
+
     if CONF_ON_LISTENING in config:
         await automation.build_automation(
             var.get_listening_trigger(), [], config[CONF_ON_LISTENING]
@@ -0,0 +1,110 @@
+#include "audio_pipeline.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace voice_assistant {
+
+/// Blocks quieter than this mean square value (-50 dBFS RMS) never count as speech
+static const float MIN_SPEECH_ENERGY = 100.0f * 100.0f;
+/// Blocks with more zero crossings per sample than this are noise rather than speech
+static const float MAX_SPEECH_ZERO_CROSSING_RATE = 0.5f;
+
+static inline int16_t saturate(int32_t value) {
+  return static_cast<int16_t>(std::min<int32_t>(std::max<int32_t>(value, INT16_MIN), INT16_MAX));
+}
+
+HighPassFilter::HighPassFilter(float cutoff_frequency, uint32_t sample_rate) {
+  float alpha = 1.0f / (1.0f + 2.0f * float(M_PI) * cutoff_frequency / float(sample_rate));
+  this->alpha_ = static_cast<int32_t>(std::lround(alpha * 32768.0f));
+}
+
+void HighPassFilter::process(int16_t *samples, size_t len) {
+  int32_t last_input = this->last_input_;
+  int32_t last_output = this->last_output_;
+  for (size_t i = 0; i < len; i++) {
+    int32_t input = samples[i];
+    int64_t output = (int64_t(this->alpha_) * (last_output + input - last_input)) >> 15;
+    last_input = input;
+    last_output = static_cast<int32_t>(output);
+    samples[i] = saturate(last_output);
+  }
+  this->last_input_ = last_input;
+  this->last_output_ = last_output;
+}
+
+void HighPassFilter::reset() {
+  this->last_input_ = 0;
+  this->last_output_ = 0;
+}
+
+AutomaticGainControl::AutomaticGainControl(float target_level, float max_gain)
+    : target_(32767.0f * powf(10.0f, target_level / 20.0f)), max_gain_(powf(10.0f, max_gain / 20.0f)) {}
+
+void AutomaticGainControl::process(int16_t *samples, size_t len) {
+  if (len == 0)
+    return;
+  int32_t peak = 1;
+  for (size_t i = 0; i < len; i++)
+    peak = std::max<int32_t>(peak, std::abs(int32_t(samples[i])));
+
+  float desired = std::min(this->target_ / float(peak), this->max_gain_);
+  if (desired < this->gain_) {
+    // Reduce the gain immediately to avoid clipping, but raise it slowly so background noise isn't pumped up
+    this->gain_ = desired;
+  } else {
+    this->gain_ += (desired - this->gain_) * 0.05f;
+  }
+
+  const int32_t gain = static_cast<int32_t>(this->gain_ * 256.0f);
+  for (size_t i = 0; i < len; i++)
+    samples[i] = saturate((int32_t(samples[i]) * gain) >> 8);
+}
+
+void VoiceActivityDetector::process(int16_t *samples, size_t len) {
+  if (len == 0)
+    return;
+  int64_t sum = 0;
+  size_t crossings = 0;
+  int16_t previous = samples[0];
+  for (size_t i = 0; i < len; i++) {
+    int32_t sample = samples[i];
+    sum += sample * sample;
+    crossings += (sample ^ previous) < 0;
+    previous = samples[i];
+  }
+  const float energy = float(sum) / float(len);
+  const float zero_crossing_rate = float(crossings) / float(len);
+
+  if (this->noise_floor_ == 0.0f)
+    this->noise_floor_ = std::max(energy, 1.0f);
+
+  bool speech = energy > MIN_SPEECH_ENERGY && energy > this->noise_floor_ * this->energy_ratio_ &&
+                zero_crossing_rate < MAX_SPEECH_ZERO_CROSSING_RATE;
+  if (speech) {
+    if (this->onset_ < this->onset_blocks_)
+      this->onset_++;
+    if (this->onset_ >= this->onset_blocks_)
+      this->hangover_ = this->hangover_blocks_;
+  } else {
+    this->onset_ = 0;
+    if (this->hangover_ > 0)
+      this->hangover_--;
+    // Follow a falling noise floor immediately and a rising one slowly
+    if (energy < this->noise_floor_) {
+      this->noise_floor_ = std::max(energy, 1.0f);
+    } else {
+      this->noise_floor_ += (energy - this->noise_floor_) * 0.05f;
+    }
+  }
+}
+
+void VoiceActivityDetector::reset() {
+  this->noise_floor_ = 0.0f;
+  this->onset_ = 0;
+  this->hangover_ = 0;
+}
+
+}  // namespace voice_assistant
+}  // namespace esphome
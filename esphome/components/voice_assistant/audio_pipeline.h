@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace voice_assistant {
+
+/// A block processing stage of the audio pipeline, working in place on 16-bit mono samples.
+class AudioStage {
+ public:
+  virtual ~AudioStage() = default;
+  virtual void process(int16_t *samples, size_t len) = 0;
+  /// Forget the state carried over from previous blocks, called when a new audio stream starts.
+  virtual void reset() {}
+};
+
+/// First order high-pass filter removing DC offset and low frequency rumble.
+class HighPassFilter : public AudioStage {
+ public:
+  HighPassFilter(float cutoff_frequency, uint32_t sample_rate);
+  void process(int16_t *samples, size_t len) override;
+  void reset() override;
+
+ protected:
+  /// filter coefficient in Q15
+  int32_t alpha_;
+  int32_t last_input_{0};
+  int32_t last_output_{0};
+};
+
+/// Automatic gain control bringing the peak level of the audio towards a target level.
+class AutomaticGainControl : public AudioStage {
+ public:
+  /**
+   * @param target_level The target peak level in dBFS.
+   * @param max_gain The maximum amplification in dB.
+   */
+  AutomaticGainControl(float target_level, float max_gain);
+  void process(int16_t *samples, size_t len) override;
+  void reset() override { this->gain_ = 1.0f; }
+
+ protected:
+  float target_;
+  float max_gain_;
+  float gain_{1.0f};
+};
+
+/// Voice activity detection based on the block energy relative to the noise floor and the zero-crossing rate.
+class VoiceActivityDetector : public AudioStage {
+ public:
+  void process(int16_t *samples, size_t len) override;
+  void reset() override;
+
+  /// Whether the last processed block was speech.
+  bool is_speech() const { return this->hangover_ > 0; }
+
+  /// Minimum ratio of block energy to noise floor for a block to count as speech.
+  void set_energy_ratio(float energy_ratio) { this->energy_ratio_ = energy_ratio; }
+  /// Number of consecutive speech blocks needed before speech is detected.
+  void set_onset_blocks(uint8_t onset_blocks) { this->onset_blocks_ = onset_blocks; }
+  /// Number of blocks speech is still reported after the last speech block.
+  void set_hangover_blocks(uint8_t hangover_blocks) { this->hangover_blocks_ = hangover_blocks; }
+
+ protected:
+  float energy_ratio_{4.0f};
+  uint8_t onset_blocks_{3};
+  uint8_t hangover_blocks_{15};
+
+  float noise_floor_{0.0f};
+  uint8_t onset_{0};
+  uint8_t hangover_{0};
+};
+
+/// A chain of audio stages that is applied to each block in order.
+class AudioPipeline {
+ public:
+  void add_stage(std::unique_ptr<AudioStage> stage) { this->stages_.push_back(std::move(stage)); }
+  bool empty() const { return this->stages_.empty(); }
+
+  void process(int16_t *samples, size_t len) {
+    for (auto &stage : this->stages_)
+      stage->process(samples, len);
+  }
+  void reset() {
+    for (auto &stage : this->stages_)
+      stage->reset();
+  }
+
+ protected:
+  std::vector<std::unique_ptr<AudioStage>> stages_;
+};
+
+}  // namespace voice_assistant
+}  // namespace esphome
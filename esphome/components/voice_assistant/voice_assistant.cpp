@@ -4,6 +4,7 @@
 
 #include "esphome/core/log.h"
 
+#include <algorithm>
 #include <cstdio>
 
 namespace esphome {
@@ -84,6 +85,17 @@ void VoiceAssistant::setup() {
     return;
   }
 
+#ifndef USE_ESP_ADF
+  if (this->vad_ != nullptr && this->use_wake_word_) {
+    this->speech_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
+    if (this->speech_buffer_ == nullptr) {
+      ESP_LOGW(TAG, "Could not allocate speech buffer.");
+      this->mark_failed();
+      return;
+    }
+  }
+#endif
+
 #ifdef USE_ESP_ADF
   this->vad_instance_ = vad_create(VAD_MODE_4);
 
@@ -112,6 +124,7 @@ int VoiceAssistant::read_microphone_() {
       memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
       return 0;
     }
+    this->audio_pipeline_.process(this->input_buffer_, bytes_read / sizeof(int16_t));
 #ifdef USE_ESP_ADF
     // Write audio into ring buffer
     int available = rb_bytes_available(this->ring_buffer_);
@@ -119,6 +132,14 @@ int VoiceAssistant::read_microphone_() {
       rb_read(this->ring_buffer_, nullptr, bytes_read - available, 0);
     }
     rb_write(this->ring_buffer_, (char *) this->input_buffer_, bytes_read, 0);
+#else
+    if (this->speech_buffer_ != nullptr) {
+      // Drop the oldest audio when the buffer is full
+      size_t free = this->speech_buffer_->free();
+      if (free < bytes_read)
+        this->speech_buffer_->commit_read(bytes_read - free);
+      this->speech_buffer_->write(this->input_buffer_, bytes_read);
+    }
 #endif
   } else {
     ESP_LOGD(TAG, "microphone not running");
@@ -126,6 +147,39 @@ int VoiceAssistant::read_microphone_() {
   return bytes_read;
 }
 
+bool VoiceAssistant::wait_for_speech_() const {
+#ifdef USE_ESP_ADF
+  return this->use_wake_word_;
+#else
+  return this->use_wake_word_ && this->vad_ != nullptr;
+#endif
+}
+
+void VoiceAssistant::reset_speech_buffer_() {
+#ifdef USE_ESP_ADF
+  rb_reset(this->ring_buffer_);
+#else
+  if (this->speech_buffer_ != nullptr)
+    this->speech_buffer_->reset();
+#endif
+}
+
+void VoiceAssistant::set_high_pass_frequency(float frequency) {
+  this->audio_pipeline_.add_stage(make_unique<HighPassFilter>(frequency, SAMPLE_RATE_HZ));
+}
+
+void VoiceAssistant::set_auto_gain_control(float target_level, float max_gain) {
+  this->audio_pipeline_.add_stage(make_unique<AutomaticGainControl>(target_level, max_gain));
+}
+
+void VoiceAssistant::set_voice_activity_detection(bool voice_activity_detection) {
+  if (!voice_activity_detection || this->vad_ != nullptr)
+    return;
+  auto vad = make_unique<VoiceActivityDetector>();
+  this->vad_ = vad.get();
+  this->audio_pipeline_.add_stage(std::move(vad));
+}
+
 void VoiceAssistant::loop() {
   if (this->api_client_ == nullptr && this->state_ != State::IDLE && this->state_ != State::STOP_MICROPHONE &&
       this->state_ != State::STOPPING_MICROPHONE) {
@@ -141,13 +195,10 @@ void VoiceAssistant::loop() {
   switch (this->state_) {
     case State::IDLE: {
       if (this->continuous_ && this->desired_state_ == State::IDLE) {
-#ifdef USE_ESP_ADF
-        if (this->use_wake_word_) {
-          rb_reset(this->ring_buffer_);
+        if (this->wait_for_speech_()) {
+          this->reset_speech_buffer_();
           this->set_state_(State::START_MICROPHONE, State::WAIT_FOR_VAD);
-        } else
-#endif
-        {
+        } else {
           this->set_state_(State::START_PIPELINE, State::START_MICROPHONE);
         }
       } else {
@@ -159,6 +210,7 @@ void VoiceAssistant::loop() {
       ESP_LOGD(TAG, "Starting Microphone");
       memset(this->send_buffer_, 0, SEND_BUFFER_SIZE);
       memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
+      this->audio_pipeline_.reset();
       this->mic_->start();
       this->high_freq_.start();
       this->set_state_(State::STARTING_MICROPHONE);
@@ -170,7 +222,6 @@ void VoiceAssistant::loop() {
       }
       break;
     }
-#ifdef USE_ESP_ADF
     case State::WAIT_FOR_VAD: {
       this->read_microphone_();
       ESP_LOGD(TAG, "Waiting for speech...");
@@ -179,6 +230,12 @@ void VoiceAssistant::loop() {
     }
     case State::WAITING_FOR_VAD: {
       size_t bytes_read = this->read_microphone_();
+#ifndef USE_ESP_ADF
+      if (bytes_read > 0 && this->vad_->is_speech()) {
+        ESP_LOGD(TAG, "VAD detected speech");
+        this->set_state_(State::START_PIPELINE, State::STREAMING_MICROPHONE);
+      }
+#else
       if (bytes_read > 0) {
         vad_state_t vad_state =
             vad_process(this->vad_instance_, this->input_buffer_, SAMPLE_RATE_HZ, VAD_FRAME_LENGTH_MS);
@@ -198,9 +255,9 @@ void VoiceAssistant::loop() {
           }
         }
       }
+#endif
       break;
     }
-#endif
     case State::START_PIPELINE: {
       this->read_microphone_();
       ESP_LOGD(TAG, "Requesting start...");
@@ -236,14 +293,39 @@ void VoiceAssistant::loop() {
       break;  // State changed when udp server port received
     }
     case State::STREAMING_MICROPHONE: {
-      size_t bytes_read = this->read_microphone_();
 #ifdef USE_ESP_ADF
+      this->read_microphone_();
       if (rb_bytes_filled(this->ring_buffer_) >= SEND_BUFFER_SIZE) {
         rb_read(this->ring_buffer_, (char *) this->send_buffer_, SEND_BUFFER_SIZE, 0);
         this->socket_->sendto(this->send_buffer_, SEND_BUFFER_SIZE, 0, (struct sockaddr *) &this->dest_addr_,
                               sizeof(this->dest_addr_));
       }
 #else
+      if (this->speech_buffer_ != nullptr) {
+        this->read_microphone_();
+        if (this->speech_buffer_->available() >= SEND_BUFFER_SIZE) {
+          this->speech_buffer_->read(this->send_buffer_, SEND_BUFFER_SIZE);
+          this->socket_->sendto(this->send_buffer_, SEND_BUFFER_SIZE, 0, (struct sockaddr *) &this->dest_addr_,
+                                sizeof(this->dest_addr_));
+        }
+        break;
+      }
+      RingBuffer *mic_buffer = this->mic_->get_ring_buffer();
+      if (mic_buffer != nullptr) {
+        // Send straight from the microphone buffer, a span ends at the end of the buffer so this takes two loops
+        // when the data wraps around
+        size_t len;
+        uint8_t *data = mic_buffer->read_span(&len);
+        len = std::min(len, SEND_BUFFER_SIZE);
+        len -= len % sizeof(int16_t);
+        if (len > 0) {
+          this->audio_pipeline_.process(reinterpret_cast<int16_t *>(data), len / sizeof(int16_t));
+          this->socket_->sendto(data, len, 0, (struct sockaddr *) &this->dest_addr_, sizeof(this->dest_addr_));
+          mic_buffer->commit_read(len);
+        }
+        break;
+      }
+      size_t bytes_read = this->read_microphone_();
       if (bytes_read > 0) {
         this->socket_->sendto(this->input_buffer_, bytes_read, 0, (struct sockaddr *) &this->dest_addr_,
                               sizeof(this->dest_addr_));
@@ -446,13 +528,10 @@ void VoiceAssistant::request_start(bool continuous, bool silence_detection) {
   if (this->state_ == State::IDLE) {
     this->continuous_ = continuous;
     this->silence_detection_ = silence_detection;
-#ifdef USE_ESP_ADF
-    if (this->use_wake_word_) {
-      rb_reset(this->ring_buffer_);
+    if (this->wait_for_speech_()) {
+      this->reset_speech_buffer_();
       this->set_state_(State::START_MICROPHONE, State::WAIT_FOR_VAD);
-    } else
-#endif
-    {
+    } else {
       this->set_state_(State::START_PIPELINE, State::START_MICROPHONE);
     }
   }
@@ -583,14 +662,11 @@ void VoiceAssistant::on_event(const api::VoiceAssistantEventResponse &msg) {
     case api::enums::VOICE_ASSISTANT_RUN_END: {
       ESP_LOGD(TAG, "Assist Pipeline ended");
       if (this->state_ == State::STREAMING_MICROPHONE) {
-#ifdef USE_ESP_ADF
-        if (this->use_wake_word_) {
-          rb_reset(this->ring_buffer_);
+        if (this->wait_for_speech_()) {
+          this->reset_speech_buffer_();
           // No need to stop the microphone since we didn't use the speaker
           this->set_state_(State::WAIT_FOR_VAD, State::WAITING_FOR_VAD);
-        } else
-#endif
-        {
+        } else {
           this->set_state_(State::IDLE, State::IDLE);
         }
       }
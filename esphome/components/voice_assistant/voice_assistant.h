@@ -7,6 +7,9 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/ring_buffer.h"
+
+#include "audio_pipeline.h"
 
 #include "esphome/components/api/api_connection.h"
 #include "esphome/components/api/api_pb2.h"
@@ -100,6 +103,13 @@ class VoiceAssistant : public Component {
   void set_auto_gain(uint8_t auto_gain) { this->auto_gain_ = auto_gain; }
   void set_volume_multiplier(float volume_multiplier) { this->volume_multiplier_ = volume_multiplier; }
 
+  /// Add a high-pass filter to the on-device audio processing.
+  void set_high_pass_frequency(float frequency);
+  /// Add automatic gain control to the on-device audio processing, levels are in dBFS and dB.
+  void set_auto_gain_control(float target_level, float max_gain);
+  /// Detect speech on the device, so in wake word mode audio is only streamed once speech is detected.
+  void set_voice_activity_detection(bool voice_activity_detection);
+
   Trigger<> *get_listening_trigger() const { return this->listening_trigger_; }
   Trigger<> *get_start_trigger() const { return this->start_trigger_; }
   Trigger<> *get_wake_word_detected_trigger() const { return this->wake_word_detected_trigger_; }
@@ -117,6 +127,9 @@ class VoiceAssistant : public Component {
 
  protected:
   int read_microphone_();
+  /// Whether audio is only streamed after speech was detected on the device.
+  bool wait_for_speech_() const;
+  void reset_speech_buffer_();
   void set_state_(State state);
   void set_state_(State state, State desired_state);
   void signal_stop_();
@@ -163,6 +176,12 @@ class VoiceAssistant : public Component {
   uint8_t vad_counter_{0};
 #endif
 
+  AudioPipeline audio_pipeline_;
+  /// owned by audio_pipeline_
+  VoiceActivityDetector *vad_{nullptr};
+  /// audio recorded while waiting for speech, so the start of the utterance is streamed too
+  std::unique_ptr<RingBuffer> speech_buffer_;
+
   bool use_wake_word_;
   uint8_t noise_suppression_level_;
   uint8_t auto_gain_;
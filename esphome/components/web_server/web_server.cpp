@@ -11,7 +11,9 @@
 #include "StreamString.h"
 #endif
 
+#include <cinttypes>
 #include <cstdlib>
+#include <cstring>
 
 #ifdef USE_LIGHT
 #include "esphome/components/light/light_json_schema.h"
@@ -33,6 +35,8 @@ namespace esphome {
 namespace web_server {
 
 static const char *const TAG = "web_server";
+/// Log lines kept while waiting for the next batch of events
+static const size_t MAX_PENDING_LOG_EVENTS = 32;
 
 #ifdef USE_WEBSERVER_PRIVATE_NETWORK_ACCESS
 static const char *const HEADER_PNA_NAME = "Private-Network-Access-Name";
@@ -64,29 +68,27 @@ void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &
 }
 #endif
 
-UrlMatch match_url(const std::string &url, bool only_domain = false) {
+UrlMatch match_url(const char *url, size_t len, bool only_domain = false) {
   UrlMatch match;
   match.valid = false;
-  size_t domain_end = url.find('/', 1);
-  if (domain_end == std::string::npos)
+  const char *end = url + len;
+  const char *domain_end = len > 1 ? static_cast<const char *>(memchr(url + 1, '/', len - 1)) : nullptr;
+  if (domain_end == nullptr)
     return match;
-  match.domain = url.substr(1, domain_end - 1);
+  match.domain = StringRef(url + 1, domain_end - url - 1);
   if (only_domain) {
     match.valid = true;
     return match;
   }
-  if (url.length() == domain_end - 1)
-    return match;
-  size_t id_begin = domain_end + 1;
-  size_t id_end = url.find('/', id_begin);
+  const char *id_begin = domain_end + 1;
+  const char *id_end = static_cast<const char *>(memchr(id_begin, '/', end - id_begin));
   match.valid = true;
-  if (id_end == std::string::npos) {
-    match.id = url.substr(id_begin, url.length() - id_begin);
+  if (id_end == nullptr) {
+    match.id = StringRef(id_begin, end - id_begin);
     return match;
   }
-  match.id = url.substr(id_begin, id_end - id_begin);
-  size_t method_begin = id_end + 1;
-  match.method = url.substr(method_begin, url.length() - method_begin);
+  match.id = StringRef(id_begin, id_end - id_begin);
+  match.method = StringRef(id_end + 1, end - id_end - 1);
   return match;
 }
 
@@ -110,18 +112,19 @@ void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_
 #endif
 
 std::string WebServer::get_config_json() {
-  return json::build_json([this](JsonObject root) {
-    root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
-    root["comment"] = App.get_comment();
-    root["ota"] = this->allow_ota_;
-    root["log"] = this->expose_log_;
-    root["lang"] = "en";
+  return json::write_json([this](json::JsonWriter &root) {
+    root.add("title", App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name());
+    root.add("comment", App.get_comment());
+    root.add("ota", this->allow_ota_);
+    root.add("log", this->expose_log_);
+    root.add("lang", "en");
   });
 }
 
 void WebServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up web server...");
   this->setup_controller(this->include_internal_);
+  this->setup_routes_();
   this->base_->init();
 
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
@@ -134,7 +137,7 @@ void WebServer::setup() {
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr && this->expose_log_) {
     logger::global_logger->add_on_log_callback(
-        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+        [this](int level, const char *tag, const char *message) { this->defer_log_event_(message); });
   }
 #endif
   this->base_->add_handler(&this->events_);
@@ -163,6 +166,66 @@ void WebServer::loop() {
   }
 #endif
   this->entities_iterator_.advance();
+
+  const uint32_t now = millis();
+  if (now - this->last_events_sent_ >= this->event_interval_) {
+    this->last_events_sent_ = now;
+    this->send_events_();
+  }
+#ifdef USE_ESP_IDF
+  this->events_.loop();
+#endif
+}
+void WebServer::defer_state_event_(EntityBase *entity, std::function<std::string()> &&json) {
+  if (this->events_.count() == 0)
+    return;
+  // the JSON is built when the event is sent, so a queued event of the entity already carries the latest state
+  if (this->pending_state_index_.count(entity) != 0)
+    return;
+  this->pending_state_index_[entity] = this->pending_states_.size();
+  this->pending_states_.push_back({entity, std::move(json)});
+}
+void WebServer::send_state_event_(EntityBase *entity, const std::string &json, bool config) {
+#ifdef USE_ESP_IDF
+  // the entity lets the event source replace a state event of the entity that a slow client hasn't taken yet
+  this->events_.send_state(json.c_str(), entity, config);
+#else
+  this->events_.send(json.c_str(), "state");
+#endif
+}
+void WebServer::defer_log_event_(const char *message) {
+  if (this->events_.count() == 0)
+    return;
+  LockGuard guard(this->pending_logs_lock_);
+  if (this->pending_logs_.size() >= MAX_PENDING_LOG_EVENTS) {
+    this->pending_logs_.pop_front();
+    this->dropped_logs_++;
+  }
+  this->pending_logs_.emplace_back(message);
+}
+void WebServer::send_events_() {
+  // state events take priority, a burst of log lines must not delay them
+  for (auto &pending : this->pending_states_)
+    this->send_state_event_(pending.entity, pending.json(), false);
+  this->pending_states_.clear();
+  this->pending_state_index_.clear();
+
+  std::deque<std::string> logs;
+  uint32_t dropped;
+  {
+    LockGuard guard(this->pending_logs_lock_);
+    logs.swap(this->pending_logs_);
+    dropped = this->dropped_logs_;
+    this->dropped_logs_ = 0;
+  }
+  if (dropped != 0) {
+    // not sent through the logger, that would queue it again
+    char buf[48];
+    snprintf(buf, sizeof(buf), "[W][%s]: %" PRIu32 " log lines dropped", TAG, dropped);
+    this->events_.send(buf, "log", millis());
+  }
+  for (auto &line : logs)
+    this->events_.send(line.c_str(), "log", millis());
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -396,37 +459,32 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 #endif
 
 #define set_json_id(root, obj, sensor, start_config) \
-  (root)["id"] = sensor; \
+  (root).add("id", sensor); \
   if (((start_config) == DETAIL_ALL)) \
-    (root)["name"] = (obj)->get_name();
+    (root).add("name", (obj)->get_name());
 
 #define set_json_value(root, obj, sensor, value, start_config) \
-  set_json_id((root), (obj), sensor, start_config)(root)["value"] = value;
+  set_json_id((root), (obj), sensor, start_config)(root).add("value", value);
 
 #define set_json_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state;
+  set_json_value(root, obj, sensor, value, start_config)(root).add("state", state);
 
 #define set_json_icon_state_value(root, obj, sensor, state, value, start_config) \
-  set_json_value(root, obj, sensor, value, start_config)(root)["state"] = state; \
+  set_json_value(root, obj, sensor, value, start_config)(root).add("state", state); \
   if (((start_config) == DETAIL_ALL)) \
-    (root)["icon"] = (obj)->get_icon();
+    (root).add("icon", (obj)->get_icon());
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->sensor_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
-    return;
-  }
-  request->send(404);
+  auto *obj = static_cast<sensor::Sensor *>(match.entity);
+  std::string data = this->sensor_json(obj, obj->state, DETAIL_STATE);
+  request->send(200, "application/json", data.c_str());
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     std::string state;
     if (std::isnan(value)) {
       state = "NA";
@@ -442,21 +500,16 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->text_sensor_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->text_sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
-    return;
-  }
-  request->send(404);
+  auto *obj = static_cast<text_sensor::TextSensor *>(match.entity);
+  std::string data = this->text_sensor_json(obj, obj->state, DETAIL_STATE);
+  request->send(200, "application/json", data.c_str());
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
   });
 }
@@ -464,255 +517,230 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->switch_json(obj, obj->state, DETAIL_STATE); });
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
     if (start_config == DETAIL_ALL) {
-      root["assumed_state"] = obj->assumed_state();
+      root.add("assumed_state", obj->assumed_state());
     }
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->schedule_([obj]() { obj->toggle(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      this->schedule_([obj]() { obj->turn_on(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->schedule_([obj]() { obj->turn_off(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
-    return;
+  auto *obj = static_cast<switch_::Switch *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->switch_json(obj, obj->state, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+  } else if (match.method == "toggle") {
+    this->schedule_([obj]() { obj->toggle(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    this->schedule_([obj]() { obj->turn_on(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    this->schedule_([obj]() { obj->turn_off(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_BUTTON
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json(
-      [obj, start_config](JsonObject root) { set_json_id(root, obj, "button-" + obj->get_object_id(), start_config); });
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
+    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
+  });
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    if (request->method() == HTTP_POST && match.method == "press") {
-      this->schedule_([obj]() { obj->press(); });
-      request->send(200);
-      return;
-    } else {
-      request->send(404);
-    }
-    return;
+  auto *obj = static_cast<button::Button *>(match.entity);
+  if (request->method() == HTTP_POST && match.method == "press") {
+    this->schedule_([obj]() { obj->press(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->binary_sensor_json(obj, obj->state, DETAIL_STATE); });
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
-    request->send(200, "application/json", data.c_str());
-    return;
-  }
-  request->send(404);
+  auto *obj = static_cast<binary_sensor::BinarySensor *>(match.entity);
+  std::string data = this->binary_sensor_json(obj, obj->state, DETAIL_STATE);
+  request->send(200, "application/json", data.c_str());
 }
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state"); }
+void WebServer::on_fan_update(fan::Fan *obj) {
+  this->defer_state_event_(obj, [this, obj]() { return this->fan_json(obj, DETAIL_STATE); });
+}
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state, start_config);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
-      root["speed_level"] = obj->speed;
-      root["speed_count"] = traits.supported_speed_count();
+      root.add("speed_level", obj->speed);
+      root.add("speed_count", traits.supported_speed_count());
     }
     if (obj->get_traits().supports_oscillation())
-      root["oscillation"] = obj->oscillating;
+      root.add("oscillation", obj->oscillating);
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->schedule_([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("speed_level")) {
-        auto speed_level = request->getParam("speed_level")->value();
-        auto val = parse_number<int>(speed_level.c_str());
-        if (!val.has_value()) {
-          ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
-          return;
-        }
-        call.set_speed(*val);
+  auto *obj = static_cast<fan::Fan *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->fan_json(obj, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+  } else if (match.method == "toggle") {
+    this->schedule_([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    auto call = obj->turn_on();
+    if (request->hasParam("speed_level")) {
+      auto speed_level = request->getParam("speed_level")->value();
+      auto val = parse_number<int>(speed_level.c_str());
+      if (!val.has_value()) {
+        ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+        return;
       }
-      if (request->hasParam("oscillation")) {
-        auto speed = request->getParam("oscillation")->value();
-        auto val = parse_on_off(speed.c_str());
-        switch (val) {
-          case PARSE_ON:
-            call.set_oscillating(true);
-            break;
-          case PARSE_OFF:
-            call.set_oscillating(false);
-            break;
-          case PARSE_TOGGLE:
-            call.set_oscillating(!obj->oscillating);
-            break;
-          case PARSE_NONE:
-            request->send(404);
-            return;
-        }
+      call.set_speed(*val);
+    }
+    if (request->hasParam("oscillation")) {
+      auto speed = request->getParam("oscillation")->value();
+      auto val = parse_on_off(speed.c_str());
+      switch (val) {
+        case PARSE_ON:
+          call.set_oscillating(true);
+          break;
+        case PARSE_OFF:
+          call.set_oscillating(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_oscillating(!obj->oscillating);
+          break;
+        case PARSE_NONE:
+          request->send(404);
+          return;
       }
-      this->schedule_([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->schedule_([obj]() { obj->turn_off().perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->schedule_([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    this->schedule_([obj]() { obj->turn_off().perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->light_json(obj, DETAIL_STATE); });
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->schedule_([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("brightness")) {
-        auto brightness = parse_number<float>(request->getParam("brightness")->value().c_str());
-        if (brightness.has_value()) {
-          call.set_brightness(*brightness / 255.0f);
-        }
-      }
-      if (request->hasParam("r")) {
-        auto r = parse_number<float>(request->getParam("r")->value().c_str());
-        if (r.has_value()) {
-          call.set_red(*r / 255.0f);
-        }
+  auto *obj = static_cast<light::LightState *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->light_json(obj, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+  } else if (match.method == "toggle") {
+    this->schedule_([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method == "turn_on") {
+    auto call = obj->turn_on();
+    if (request->hasParam("brightness")) {
+      auto brightness = parse_number<float>(request->getParam("brightness")->value().c_str());
+      if (brightness.has_value()) {
+        call.set_brightness(*brightness / 255.0f);
       }
-      if (request->hasParam("g")) {
-        auto g = parse_number<float>(request->getParam("g")->value().c_str());
-        if (g.has_value()) {
-          call.set_green(*g / 255.0f);
-        }
+    }
+    if (request->hasParam("r")) {
+      auto r = parse_number<float>(request->getParam("r")->value().c_str());
+      if (r.has_value()) {
+        call.set_red(*r / 255.0f);
       }
-      if (request->hasParam("b")) {
-        auto b = parse_number<float>(request->getParam("b")->value().c_str());
-        if (b.has_value()) {
-          call.set_blue(*b / 255.0f);
-        }
+    }
+    if (request->hasParam("g")) {
+      auto g = parse_number<float>(request->getParam("g")->value().c_str());
+      if (g.has_value()) {
+        call.set_green(*g / 255.0f);
       }
-      if (request->hasParam("white_value")) {
-        auto white_value = parse_number<float>(request->getParam("white_value")->value().c_str());
-        if (white_value.has_value()) {
-          call.set_white(*white_value / 255.0f);
-        }
+    }
+    if (request->hasParam("b")) {
+      auto b = parse_number<float>(request->getParam("b")->value().c_str());
+      if (b.has_value()) {
+        call.set_blue(*b / 255.0f);
       }
-      if (request->hasParam("color_temp")) {
-        auto color_temp = parse_number<float>(request->getParam("color_temp")->value().c_str());
-        if (color_temp.has_value()) {
-          call.set_color_temperature(*color_temp);
-        }
+    }
+    if (request->hasParam("white_value")) {
+      auto white_value = parse_number<float>(request->getParam("white_value")->value().c_str());
+      if (white_value.has_value()) {
+        call.set_white(*white_value / 255.0f);
       }
-      if (request->hasParam("flash")) {
-        auto flash = parse_number<uint32_t>(request->getParam("flash")->value().c_str());
-        if (flash.has_value()) {
-          call.set_flash_length(*flash * 1000);
-        }
+    }
+    if (request->hasParam("color_temp")) {
+      auto color_temp = parse_number<float>(request->getParam("color_temp")->value().c_str());
+      if (color_temp.has_value()) {
+        call.set_color_temperature(*color_temp);
       }
-      if (request->hasParam("transition")) {
-        auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
-        if (transition.has_value()) {
-          call.set_transition_length(*transition * 1000);
-        }
+    }
+    if (request->hasParam("flash")) {
+      auto flash = parse_number<uint32_t>(request->getParam("flash")->value().c_str());
+      if (flash.has_value()) {
+        call.set_flash_length(*flash * 1000);
       }
-      if (request->hasParam("effect")) {
-        const char *effect = request->getParam("effect")->value().c_str();
-        call.set_effect(effect);
+    }
+    if (request->hasParam("transition")) {
+      auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
+      if (transition.has_value()) {
+        call.set_transition_length(*transition * 1000);
       }
+    }
+    if (request->hasParam("effect")) {
+      const char *effect = request->getParam("effect")->value().c_str();
+      call.set_effect(effect);
+    }
 
-      this->schedule_([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      auto call = obj->turn_off();
-      if (request->hasParam("transition")) {
-        auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
-        if (transition.has_value()) {
-          call.set_transition_length(*transition * 1000);
-        }
+    this->schedule_([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method == "turn_off") {
+    auto call = obj->turn_off();
+    if (request->hasParam("transition")) {
+      auto transition = parse_number<uint32_t>(request->getParam("transition")->value().c_str());
+      if (transition.has_value()) {
+        call.set_transition_length(*transition * 1000);
       }
-      this->schedule_([call]() mutable { call.perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->schedule_([call]() mutable { call.perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
-    root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
+    root.add("state", obj->remote_values.is_on() ? "ON" : "OFF");
 
     light::LightJSONSchema::dump_json(*obj, root);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("effects");
-      opt.add("None");
+      root.begin_array("effects");
+      root.value("None");
       for (auto const &option : obj->get_effects()) {
-        opt.add(option->get_name());
+        root.value(option->get_name());
       }
+      root.end_array();
     }
   });
 }
@@ -720,120 +748,108 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->cover_json(obj, DETAIL_STATE); });
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      continue;
-    }
+  auto *obj = static_cast<cover::Cover *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->cover_json(obj, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
-    if (match.method == "open") {
-      call.set_command_open();
-    } else if (match.method == "close") {
-      call.set_command_close();
-    } else if (match.method == "stop") {
-      call.set_command_stop();
-    } else if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  auto call = obj->make_call();
+  if (match.method == "open") {
+    call.set_command_open();
+  } else if (match.method == "close") {
+    call.set_command_close();
+  } else if (match.method == "stop") {
+    call.set_command_stop();
+  } else if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    auto traits = obj->get_traits();
-    if ((request->hasParam("position") && !traits.get_supports_position()) ||
-        (request->hasParam("tilt") && !traits.get_supports_tilt())) {
-      request->send(409);
-      return;
-    }
+  auto traits = obj->get_traits();
+  if ((request->hasParam("position") && !traits.get_supports_position()) ||
+      (request->hasParam("tilt") && !traits.get_supports_tilt())) {
+    request->send(409);
+    return;
+  }
 
-    if (request->hasParam("position")) {
-      auto position = parse_number<float>(request->getParam("position")->value().c_str());
-      if (position.has_value()) {
-        call.set_position(*position);
-      }
+  if (request->hasParam("position")) {
+    auto position = parse_number<float>(request->getParam("position")->value().c_str());
+    if (position.has_value()) {
+      call.set_position(*position);
     }
-    if (request->hasParam("tilt")) {
-      auto tilt = parse_number<float>(request->getParam("tilt")->value().c_str());
-      if (tilt.has_value()) {
-        call.set_tilt(*tilt);
-      }
+  }
+  if (request->hasParam("tilt")) {
+    auto tilt = parse_number<float>(request->getParam("tilt")->value().c_str());
+    if (tilt.has_value()) {
+      call.set_tilt(*tilt);
     }
-
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
   }
-  request->send(404);
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
                          obj->position, start_config);
-    root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
+    root.add("current_operation", cover::cover_operation_to_str(obj->current_operation));
 
     if (obj->get_traits().get_supports_tilt())
-      root["tilt"] = obj->tilt;
+      root.add("tilt", obj->tilt);
   });
 }
 #endif
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->number_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->number_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
-
-    auto call = obj->make_call();
-    if (request->hasParam("value")) {
-      auto value = parse_number<float>(request->getParam("value")->value().c_str());
-      if (value.has_value())
-        call.set_value(*value);
-    }
-
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
+  auto *obj = static_cast<number::Number *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->number_json(obj, obj->state, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
     return;
   }
-  request->send(404);
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
+
+  auto call = obj->make_call();
+  if (request->hasParam("value")) {
+    auto value = parse_number<float>(request->getParam("value")->value().c_str());
+    if (value.has_value())
+      call.set_value(*value);
+  }
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
-      root["min_value"] = obj->traits.get_min_value();
-      root["max_value"] = obj->traits.get_max_value();
-      root["step"] = obj->traits.get_step();
-      root["mode"] = (int) obj->traits.get_mode();
+      root.add("min_value", obj->traits.get_min_value());
+      root.add("max_value", obj->traits.get_max_value());
+      root.add("step", obj->traits.get_step());
+      root.add("mode", (int) obj->traits.get_mode());
     }
     if (std::isnan(value)) {
-      root["value"] = "\"NaN\"";
-      root["state"] = "NA";
+      root.add("value", "\"NaN\"");
+      root.add("state", "NA");
     } else {
-      root["value"] = value;
+      root.add("value", value);
       std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
       if (!obj->traits.get_unit_of_measurement().empty())
         state += " " + obj->traits.get_unit_of_measurement();
-      root["state"] = state;
+      root.add("state", state);
     }
   });
 }
@@ -841,101 +857,90 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 
 #ifdef USE_TEXT
 void WebServer::on_text_update(text::Text *obj, const std::string &state) {
-  this->events_.send(this->text_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->text_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_texts()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->text_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
-
-    auto call = obj->make_call();
-    if (request->hasParam("value")) {
-      String value = request->getParam("value")->value();
-      call.set_value(value.c_str());
-    }
-
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
+  auto *obj = static_cast<text::Text *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->text_json(obj, obj->state, DETAIL_STATE);
+    request->send(200, "text/json", data.c_str());
     return;
   }
-  request->send(404);
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
+
+  auto call = obj->make_call();
+  if (request->hasParam("value")) {
+    String value = request->getParam("value")->value();
+    call.set_value(value.c_str());
+  }
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 
 std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
-      root["mode"] = (int) obj->traits.get_mode();
+      root.add("mode", (int) obj->traits.get_mode());
     }
-    root["min_length"] = obj->traits.get_min_length();
-    root["max_length"] = obj->traits.get_max_length();
-    root["pattern"] = obj->traits.get_pattern();
+    root.add("min_length", obj->traits.get_min_length());
+    root.add("max_length", obj->traits.get_max_length());
+    root.add("pattern", obj->traits.get_pattern());
     if (obj->traits.get_mode() == text::TextMode::TEXT_MODE_PASSWORD) {
-      root["state"] = "********";
+      root.add("state", "********");
     } else {
-      root["state"] = value;
+      root.add("state", value);
     }
-    root["value"] = value;
+    root.add("value", value);
   });
 }
 #endif
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->select_json(obj, obj->state, DETAIL_STATE); });
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      auto detail = DETAIL_STATE;
-      auto *param = request->getParam("detail");
-      if (param && param->value() == "all") {
-        detail = DETAIL_ALL;
-      }
-      std::string data = this->select_json(obj, obj->state, detail);
-      request->send(200, "application/json", data.c_str());
-      return;
+  auto *obj = static_cast<select::Select *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    auto detail = DETAIL_STATE;
+    auto *param = request->getParam("detail");
+    if (param && param->value() == "all") {
+      detail = DETAIL_ALL;
     }
+    std::string data = this->select_json(obj, obj->state, detail);
+    request->send(200, "application/json", data.c_str());
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    auto call = obj->make_call();
+  auto call = obj->make_call();
 
-    if (request->hasParam("option")) {
-      auto option = request->getParam("option")->value();
-      call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
-    }
-
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("option")) {
+    auto option = request->getParam("option")->value();
+    call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
   }
-  request->send(404);
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
+      root.begin_array("option");
       for (auto &option : obj->traits.get_options()) {
-        opt.add(option);
+        root.value(option);
       }
+      root.end_array();
     }
   });
 }
@@ -946,59 +951,53 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_CLIMATE
 void WebServer::on_climate_update(climate::Climate *obj) {
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->climate_json(obj, DETAIL_STATE); });
 }
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_climates()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->climate_json(obj, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
-
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  auto *obj = static_cast<climate::Climate *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->climate_json(obj, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (match.method != "set") {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("mode")) {
-      auto mode = request->getParam("mode")->value();
-      call.set_mode(mode.c_str());
-    }
+  auto call = obj->make_call();
 
-    if (request->hasParam("target_temperature_high")) {
-      auto target_temperature_high = parse_number<float>(request->getParam("target_temperature_high")->value().c_str());
-      if (target_temperature_high.has_value())
-        call.set_target_temperature_high(*target_temperature_high);
-    }
+  if (request->hasParam("mode")) {
+    auto mode = request->getParam("mode")->value();
+    call.set_mode(mode.c_str());
+  }
 
-    if (request->hasParam("target_temperature_low")) {
-      auto target_temperature_low = parse_number<float>(request->getParam("target_temperature_low")->value().c_str());
-      if (target_temperature_low.has_value())
-        call.set_target_temperature_low(*target_temperature_low);
-    }
+  if (request->hasParam("target_temperature_high")) {
+    auto target_temperature_high = parse_number<float>(request->getParam("target_temperature_high")->value().c_str());
+    if (target_temperature_high.has_value())
+      call.set_target_temperature_high(*target_temperature_high);
+  }
 
-    if (request->hasParam("target_temperature")) {
-      auto target_temperature = parse_number<float>(request->getParam("target_temperature")->value().c_str());
-      if (target_temperature.has_value())
-        call.set_target_temperature(*target_temperature);
-    }
+  if (request->hasParam("target_temperature_low")) {
+    auto target_temperature_low = parse_number<float>(request->getParam("target_temperature_low")->value().c_str());
+    if (target_temperature_low.has_value())
+      call.set_target_temperature_low(*target_temperature_low);
+  }
 
-    this->schedule_([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("target_temperature")) {
+    auto target_temperature = parse_number<float>(request->getParam("target_temperature")->value().c_str());
+    if (target_temperature.has_value())
+      call.set_target_temperature(*target_temperature);
   }
-  request->send(404);
+
+  this->schedule_([call]() mutable { call.perform(); });
+  request->send(200);
 }
 
 std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::write_json([obj, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
     const auto traits = obj->get_traits();
     int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
@@ -1006,80 +1005,90 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
     char buf[16];
 
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("modes");
+      root.begin_array("modes");
       for (climate::ClimateMode m : traits.get_supported_modes())
-        opt.add(PSTR_LOCAL(climate::climate_mode_to_string(m)));
+        root.value(PSTR_LOCAL(climate::climate_mode_to_string(m)));
+      root.end_array();
       if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("fan_modes");
+        root.begin_array("fan_modes");
         for (climate::ClimateFanMode m : traits.get_supported_fan_modes())
-          opt.add(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
+          root.value(PSTR_LOCAL(climate::climate_fan_mode_to_string(m)));
+        root.end_array();
       }
 
       if (!traits.get_supported_custom_fan_modes().empty()) {
-        JsonArray opt = root.createNestedArray("custom_fan_modes");
+        root.begin_array("custom_fan_modes");
         for (auto const &custom_fan_mode : traits.get_supported_custom_fan_modes())
-          opt.add(custom_fan_mode);
+          root.value(custom_fan_mode);
+        root.end_array();
       }
       if (traits.get_supports_swing_modes()) {
-        JsonArray opt = root.createNestedArray("swing_modes");
+        root.begin_array("swing_modes");
         for (auto swing_mode : traits.get_supported_swing_modes())
-          opt.add(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
+          root.value(PSTR_LOCAL(climate::climate_swing_mode_to_string(swing_mode)));
+        root.end_array();
       }
       if (traits.get_supports_presets() && obj->preset.has_value()) {
-        JsonArray opt = root.createNestedArray("presets");
+        root.begin_array("presets");
         for (climate::ClimatePreset m : traits.get_supported_presets())
-          opt.add(PSTR_LOCAL(climate::climate_preset_to_string(m)));
+          root.value(PSTR_LOCAL(climate::climate_preset_to_string(m)));
+        root.end_array();
       }
       if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-        JsonArray opt = root.createNestedArray("custom_presets");
+        root.begin_array("custom_presets");
         for (auto const &custom_preset : traits.get_supported_custom_presets())
-          opt.add(custom_preset);
+          root.value(custom_preset);
+        root.end_array();
       }
     }
 
     bool has_state = false;
-    root["mode"] = PSTR_LOCAL(climate_mode_to_string(obj->mode));
-    root["max_temp"] = value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy);
-    root["min_temp"] = value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy);
-    root["step"] = traits.get_visual_target_temperature_step();
+    root.add("mode", PSTR_LOCAL(climate_mode_to_string(obj->mode)));
+    root.add("max_temp", value_accuracy_to_string(traits.get_visual_max_temperature(), target_accuracy));
+    root.add("min_temp", value_accuracy_to_string(traits.get_visual_min_temperature(), target_accuracy));
+    root.add("step", traits.get_visual_target_temperature_step());
     if (traits.get_supports_action()) {
-      root["action"] = PSTR_LOCAL(climate_action_to_string(obj->action));
-      root["state"] = root["action"];
+      // the action is reported twice, copy it out of flash once into its own buffer
+      char action[16] = {};
+      strncpy_P(action, (PGM_P) climate_action_to_string(obj->action), sizeof(action) - 1);
+      root.add("action", action);
+      root.add("state", action);
       has_state = true;
     }
     if (traits.get_supports_fan_modes() && obj->fan_mode.has_value()) {
-      root["fan_mode"] = PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value()));
+      root.add("fan_mode", PSTR_LOCAL(climate_fan_mode_to_string(obj->fan_mode.value())));
     }
     if (!traits.get_supported_custom_fan_modes().empty() && obj->custom_fan_mode.has_value()) {
-      root["custom_fan_mode"] = obj->custom_fan_mode.value().c_str();
+      root.add("custom_fan_mode", obj->custom_fan_mode.value());
     }
     if (traits.get_supports_presets() && obj->preset.has_value()) {
-      root["preset"] = PSTR_LOCAL(climate_preset_to_string(obj->preset.value()));
+      root.add("preset", PSTR_LOCAL(climate_preset_to_string(obj->preset.value())));
     }
     if (!traits.get_supported_custom_presets().empty() && obj->custom_preset.has_value()) {
-      root["custom_preset"] = obj->custom_preset.value().c_str();
+      root.add("custom_preset", obj->custom_preset.value());
     }
     if (traits.get_supports_swing_modes()) {
-      root["swing_mode"] = PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode));
+      root.add("swing_mode", PSTR_LOCAL(climate_swing_mode_to_string(obj->swing_mode)));
     }
     if (traits.get_supports_current_temperature()) {
       if (!std::isnan(obj->current_temperature)) {
-        root["current_temperature"] = value_accuracy_to_string(obj->current_temperature, current_accuracy);
+        root.add("current_temperature", value_accuracy_to_string(obj->current_temperature, current_accuracy));
       } else {
-        root["current_temperature"] = "NA";
+        root.add("current_temperature", "NA");
       }
     }
     if (traits.get_supports_two_point_target_temperature()) {
-      root["target_temperature_low"] = value_accuracy_to_string(obj->target_temperature_low, target_accuracy);
-      root["target_temperature_high"] = value_accuracy_to_string(obj->target_temperature_high, target_accuracy);
+      root.add("target_temperature_low", value_accuracy_to_string(obj->target_temperature_low, target_accuracy));
+      root.add("target_temperature_high", value_accuracy_to_string(obj->target_temperature_high, target_accuracy));
       if (!has_state) {
-        root["state"] = value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
-                                                 target_accuracy);
+        root.add("state", value_accuracy_to_string((obj->target_temperature_high + obj->target_temperature_low) / 2.0f,
+                                                   target_accuracy));
       }
     } else {
-      root["target_temperature"] = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+      std::string target_temperature = value_accuracy_to_string(obj->target_temperature, target_accuracy);
+      root.add("target_temperature", target_temperature);
       if (!has_state)
-        root["state"] = root["target_temperature"];
+        root.add("state", target_temperature);
     }
   });
 }
@@ -1087,63 +1096,54 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(obj, [this, obj]() { return this->lock_json(obj, obj->state, DETAIL_STATE); });
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
                               start_config);
   });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->lock_json(obj, obj->state, DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-    } else if (match.method == "lock") {
-      this->schedule_([obj]() { obj->lock(); });
-      request->send(200);
-    } else if (match.method == "unlock") {
-      this->schedule_([obj]() { obj->unlock(); });
-      request->send(200);
-    } else if (match.method == "open") {
-      this->schedule_([obj]() { obj->open(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
-    return;
+  auto *obj = static_cast<lock::Lock *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->lock_json(obj, obj->state, DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+  } else if (match.method == "lock") {
+    this->schedule_([obj]() { obj->lock(); });
+    request->send(200);
+  } else if (match.method == "unlock") {
+    this->schedule_([obj]() { obj->unlock(); });
+    request->send(200);
+  } else if (match.method == "open") {
+    this->schedule_([obj]() { obj->open(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->defer_state_event_(
+      obj, [this, obj]() { return this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE); });
 }
 std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
                                                 alarm_control_panel::AlarmControlPanelState value,
                                                 JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::write_json([obj, value, start_config](json::JsonWriter &root) {
     char buf[16];
     set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
                               PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
   });
 }
 void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (alarm_control_panel::AlarmControlPanel *obj : App.get_alarm_control_panels()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE);
-      request->send(200, "application/json", data.c_str());
-      return;
-    }
+  auto *obj = static_cast<alarm_control_panel::AlarmControlPanel *>(match.entity);
+  if (request->method() == HTTP_GET) {
+    std::string data = this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE);
+    request->send(200, "application/json", data.c_str());
+    return;
   }
   request->send(404);
 }
@@ -1175,80 +1175,14 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) {
   }
 #endif
 
-  UrlMatch match = match_url(request->url().c_str(), true);
+  const auto &url = request->url();
+  UrlMatch match = match_url(url.c_str(), url.length(), true);
   if (!match.valid)
     return false;
-#ifdef USE_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "sensor")
-    return true;
-#endif
-
-#ifdef USE_SWITCH
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "switch")
-    return true;
-#endif
-
-#ifdef USE_BUTTON
-  if (request->method() == HTTP_POST && match.domain == "button")
-    return true;
-#endif
-
-#ifdef USE_BINARY_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "binary_sensor")
-    return true;
-#endif
-
-#ifdef USE_FAN
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "fan")
-    return true;
-#endif
-
-#ifdef USE_LIGHT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "light")
-    return true;
-#endif
-
-#ifdef USE_TEXT_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "text_sensor")
-    return true;
-#endif
-
-#ifdef USE_COVER
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "cover")
-    return true;
-#endif
-
-#ifdef USE_NUMBER
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "number")
-    return true;
-#endif
-
-#ifdef USE_TEXT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "text")
-    return true;
-#endif
-
-#ifdef USE_SELECT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "select")
-    return true;
-#endif
-
-#ifdef USE_CLIMATE
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "climate")
-    return true;
-#endif
-
-#ifdef USE_LOCK
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "lock")
-    return true;
-#endif
-
-#ifdef USE_ALARM_CONTROL_PANEL
-  if (request->method() == HTTP_GET && match.domain == "alarm_control_panel")
-    return true;
-#endif
-
-  return false;
+  const WebServerRoute *route = this->find_route_(match);
+  if (route == nullptr)
+    return false;
+  return (request->method() == HTTP_GET && route->allow_get) || (request->method() == HTTP_POST && route->allow_post);
 }
 void WebServer::handleRequest(AsyncWebServerRequest *request) {
   if (request->url() == "/") {
@@ -1277,109 +1211,104 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
-  UrlMatch match = match_url(request->url().c_str());
-#ifdef USE_SENSOR
-  if (match.domain == "sensor") {
-    this->handle_sensor_request(request, match);
+  const auto &url = request->url();
+  UrlMatch match = match_url(url.c_str(), url.length());
+  const WebServerRoute *route = this->find_route_(match);
+  if (route == nullptr)
     return;
+  // The hash only narrows the lookup down, the object id picks the entity among those sharing the hash
+  auto range = route->entities.equal_range(fnv1_hash(match.id.c_str(), match.id.size()));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.object_id == match.id) {
+      match.entity = it->second.entity;
+      break;
+    }
   }
-#endif
-
-#ifdef USE_SWITCH
-  if (match.domain == "switch") {
-    this->handle_switch_request(request, match);
+  if (match.entity == nullptr) {
+    request->send(404);
     return;
   }
-#endif
+  (this->*route->handler)(request, match);
+}
 
-#ifdef USE_BUTTON
-  if (match.domain == "button") {
-    this->handle_button_request(request, match);
-    return;
+bool WebServer::isRequestHandlerTrivial() { return false; }
+
+template<typename T>
+void WebServer::add_route_(const char *domain, bool allow_get, bool allow_post,
+                           void (WebServer::*handler)(AsyncWebServerRequest *request, const UrlMatch &match),
+                           const std::vector<T *> &entities) {
+  WebServerRoute &route = this->routes_[fnv1_hash(domain, strlen(domain))];
+  route.domain = domain;
+  route.allow_get = allow_get;
+  route.allow_post = allow_post;
+  route.handler = handler;
+  route.entities.reserve(entities.size());
+  for (T *obj : entities) {
+    std::string object_id = obj->get_object_id();
+    bool unique = true;
+    auto range = route.entities.equal_range(obj->get_object_id_hash());
+    for (auto it = range.first; it != range.second; ++it)
+      unique = unique && it->second.object_id != object_id;
+    if (!unique) {
+      ESP_LOGW(TAG, "Object ID of %s '%s' is not unique, it can't be reached", domain, obj->get_name().c_str());
+      continue;
+    }
+    route.entities.emplace(obj->get_object_id_hash(), WebServerRouteEntity{obj, std::move(object_id)});
   }
-#endif
+}
 
+void WebServer::setup_routes_() {
+#ifdef USE_SENSOR
+  this->add_route_("sensor", true, false, &WebServer::handle_sensor_request, App.get_sensors());
+#endif
+#ifdef USE_SWITCH
+  this->add_route_("switch", true, true, &WebServer::handle_switch_request, App.get_switches());
+#endif
+#ifdef USE_BUTTON
+  this->add_route_("button", false, true, &WebServer::handle_button_request, App.get_buttons());
+#endif
 #ifdef USE_BINARY_SENSOR
-  if (match.domain == "binary_sensor") {
-    this->handle_binary_sensor_request(request, match);
-    return;
-  }
+  this->add_route_("binary_sensor", true, false, &WebServer::handle_binary_sensor_request, App.get_binary_sensors());
 #endif
-
 #ifdef USE_FAN
-  if (match.domain == "fan") {
-    this->handle_fan_request(request, match);
-    return;
-  }
+  this->add_route_("fan", true, true, &WebServer::handle_fan_request, App.get_fans());
 #endif
-
 #ifdef USE_LIGHT
-  if (match.domain == "light") {
-    this->handle_light_request(request, match);
-    return;
-  }
+  this->add_route_("light", true, true, &WebServer::handle_light_request, App.get_lights());
 #endif
-
 #ifdef USE_TEXT_SENSOR
-  if (match.domain == "text_sensor") {
-    this->handle_text_sensor_request(request, match);
-    return;
-  }
+  this->add_route_("text_sensor", true, false, &WebServer::handle_text_sensor_request, App.get_text_sensors());
 #endif
-
 #ifdef USE_COVER
-  if (match.domain == "cover") {
-    this->handle_cover_request(request, match);
-    return;
-  }
+  this->add_route_("cover", true, true, &WebServer::handle_cover_request, App.get_covers());
 #endif
-
 #ifdef USE_NUMBER
-  if (match.domain == "number") {
-    this->handle_number_request(request, match);
-    return;
-  }
+  this->add_route_("number", true, true, &WebServer::handle_number_request, App.get_numbers());
 #endif
-
 #ifdef USE_TEXT
-  if (match.domain == "text") {
-    this->handle_text_request(request, match);
-    return;
-  }
+  this->add_route_("text", true, true, &WebServer::handle_text_request, App.get_texts());
 #endif
-
 #ifdef USE_SELECT
-  if (match.domain == "select") {
-    this->handle_select_request(request, match);
-    return;
-  }
+  this->add_route_("select", true, true, &WebServer::handle_select_request, App.get_selects());
 #endif
-
 #ifdef USE_CLIMATE
-  if (match.domain == "climate") {
-    this->handle_climate_request(request, match);
-    return;
-  }
+  this->add_route_("climate", true, true, &WebServer::handle_climate_request, App.get_climates());
 #endif
-
 #ifdef USE_LOCK
-  if (match.domain == "lock") {
-    this->handle_lock_request(request, match);
-
-    return;
-  }
+  this->add_route_("lock", true, true, &WebServer::handle_lock_request, App.get_locks());
 #endif
-
 #ifdef USE_ALARM_CONTROL_PANEL
-  if (match.domain == "alarm_control_panel") {
-    this->handle_alarm_control_panel_request(request, match);
-
-    return;
-  }
+  this->add_route_("alarm_control_panel", true, false, &WebServer::handle_alarm_control_panel_request,
+                   App.get_alarm_control_panels());
 #endif
 }
 
-bool WebServer::isRequestHandlerTrivial() { return false; }
+const WebServerRoute *WebServer::find_route_(const UrlMatch &match) const {
+  auto it = this->routes_.find(fnv1_hash(match.domain.c_str(), match.domain.size()));
+  if (it == this->routes_.end() || it->second.domain != match.domain)
+    return nullptr;
+  return &it->second;
+}
 
 void WebServer::schedule_(std::function<void()> &&f) {
 #ifdef USE_ESP32
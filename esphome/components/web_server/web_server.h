@@ -5,10 +5,14 @@
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/string_ref.h"
 
+#include <deque>
+#include <functional>
+#include <unordered_map>
 #include <vector>
 #ifdef USE_ESP32
-#include <deque>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #endif
@@ -31,16 +35,42 @@ extern const size_t ESPHOME_WEBSERVER_JS_INCLUDE_SIZE;
 namespace esphome {
 namespace web_server {
 
-/// Internal helper struct that is used to parse incoming URLs
+/// Internal helper struct that is used to parse incoming URLs, referencing the parts of the URL without copying them
 struct UrlMatch {
-  std::string domain;  ///< The domain of the component, for example "sensor"
-  std::string id;      ///< The id of the device that's being accessed, for example "living_room_fan"
-  std::string method;  ///< The method that's being called, for example "turn_on"
-  bool valid;          ///< Whether this match is valid
+  StringRef domain;              ///< The domain of the component, for example "sensor"
+  StringRef id;                  ///< The id of the device that's being accessed, for example "living_room_fan"
+  StringRef method;              ///< The method that's being called, for example "turn_on"
+  bool valid;                    ///< Whether this match is valid
+  EntityBase *entity{nullptr};  ///< The entity with the matched id, resolved by the route of the domain
 };
 
 enum JsonDetail { DETAIL_ALL, DETAIL_STATE };
 
+class WebServer;
+
+/// An entity that can be reached through a route
+struct WebServerRouteEntity {
+  EntityBase *entity;
+  /// The object id, kept so requests are matched against it without building it again
+  std::string object_id;
+};
+
+/// The handler and the entities of one REST API domain, for example "sensor"
+struct WebServerRoute {
+  const char *domain;
+  bool allow_get;
+  bool allow_post;
+  void (WebServer::*handler)(AsyncWebServerRequest *request, const UrlMatch &match);
+  /// Entities of the domain by object id hash, entities whose object ids share a hash are all kept
+  std::unordered_multimap<uint32_t, WebServerRouteEntity> entities;
+};
+
+/// A state change waiting to be sent to the event source clients, the JSON is built from the latest state when sent
+struct PendingStateEvent {
+  EntityBase *entity;
+  std::function<std::string()> json;
+};
+
 /** This class allows users to create a web server with their ESP nodes.
  *
  * Behind the scenes it's using AsyncWebServer to set up the server. It exposes 3 things:
@@ -102,6 +132,12 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    * @param expose_log.
    */
   void set_expose_log(bool expose_log) { this->expose_log_ = expose_log; }
+  /** Set the minimum time between two batches of events sent to the event source clients.
+   * State changes of an entity within this interval are coalesced into a single event with the latest state.
+   *
+   * @param event_interval The interval in milliseconds, 0 sends the events on the next loop iteration.
+   */
+  void set_event_interval(uint32_t event_interval) { this->event_interval_ = event_interval; }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -278,6 +314,21 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Queue a state event of an entity, replacing the event of the entity that is still queued.
+  void defer_state_event_(EntityBase *entity, std::function<std::string()> &&json);
+  /// Send a state event of an entity now, config tells whether it carries the full entity description.
+  void send_state_event_(EntityBase *entity, const std::string &json, bool config);
+  /// Queue a log line, dropping the oldest line when the queue is full.
+  void defer_log_event_(const char *message);
+  /// Send the queued events, state events first.
+  void send_events_();
+  /// Build the route table of the REST API, called once at setup.
+  void setup_routes_();
+  template<typename T>
+  void add_route_(const char *domain, bool allow_get, bool allow_post,
+                  void (WebServer::*handler)(AsyncWebServerRequest *request, const UrlMatch &match),
+                  const std::vector<T *> &entities);
+  const WebServerRoute *find_route_(const UrlMatch &match) const;
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
@@ -292,9 +343,20 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 #ifdef USE_WEBSERVER_JS_INCLUDE
   const char *js_include_{nullptr};
 #endif
+  /// REST API routes by domain hash
+  std::unordered_map<uint32_t, WebServerRoute> routes_;
   bool include_internal_{false};
   bool allow_ota_{true};
   bool expose_log_{true};
+  uint32_t event_interval_{100};
+  uint32_t last_events_sent_{0};
+  std::vector<PendingStateEvent> pending_states_;
+  /// Index into pending_states_ by entity
+  std::unordered_map<EntityBase *, size_t> pending_state_index_;
+  /// Log lines can be produced by other tasks, the queue is guarded by a lock
+  std::deque<std::string> pending_logs_;
+  Mutex pending_logs_lock_;
+  uint32_t dropped_logs_{0};
 #ifdef USE_ESP32
   std::deque<std::function<void()>> to_schedule_;
   SemaphoreHandle_t to_schedule_lock_;
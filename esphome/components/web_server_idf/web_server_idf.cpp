@@ -1,6 +1,11 @@
 #ifdef USE_ESP_IDF
 
+#include <algorithm>
 #include <cstdarg>
+#include <cstring>
+#include <iterator>
+
+#include <sys/socket.h>
 
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
@@ -20,6 +25,10 @@ namespace web_server_idf {
 #define CRLF_LEN (sizeof(CRLF_STR) - 1)
 
 static const char *const TAG = "web_server_idf";
+/// Log events queued per event source client, a client that falls further behind loses its oldest log events
+static const size_t MAX_QUEUED_LOG_EVENTS = 16;
+/// Events queued per event source client, a client that falls further behind is closed and resyncs on reconnect
+static const size_t MAX_QUEUED_EVENTS = 128;
 
 void AsyncWebServer::end() {
   if (this->server_) {
@@ -116,9 +125,7 @@ std::string AsyncWebServerRequest::url() const {
 
 std::string AsyncWebServerRequest::host() const { return this->get_header("Host").value(); }
 
-void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
-  httpd_resp_send(*this, response->get_content_data(), response->get_content_size());
-}
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response) { response->send_content(); }
 
 void AsyncWebServerRequest::send(int code, const char *content_type, const char *content) {
   this->init_response_(nullptr, code, content_type);
@@ -268,16 +275,41 @@ void AsyncWebServerResponse::addHeader(const char *name, const char *value) {
   httpd_resp_set_hdr(*this->req_, name, value);
 }
 
+esp_err_t AsyncWebServerResponse::send_content() {
+  return httpd_resp_send(*this->req_, this->get_content_data(), this->get_content_size());
+}
+
+esp_err_t AsyncResponseStream::send_content() {
+  if (!this->chunked_)
+    return AsyncWebServerResponse::send_content();
+  if (!this->content_.empty())
+    this->send_chunk_();
+  if (this->failed_)
+    return ESP_FAIL;
+  // an empty chunk ends the response
+  return httpd_resp_send_chunk(*this->req_, nullptr, 0);
+}
+
+void AsyncResponseStream::print(const char *str) { this->write_(str, strlen(str)); }
+
 void AsyncResponseStream::print(float value) { this->print(to_string(value)); }
 
 void AsyncResponseStream::printf(const char *fmt, ...) {
-  std::string str;
+  // most lines fit the stack buffer, only format into the heap when they don't
+  char buf[128];
   va_list args;
 
   va_start(args, fmt);
-  size_t length = vsnprintf(nullptr, 0, fmt, args);
+  int length = vsnprintf(buf, sizeof(buf), fmt, args);
   va_end(args);
+  if (length < 0)
+    return;
+  if (static_cast<size_t>(length) < sizeof(buf)) {
+    this->write_(buf, length);
+    return;
+  }
 
+  std::string str;
   str.resize(length);
   va_start(args, fmt);
   vsnprintf(&str[0], length + 1, fmt, args);
@@ -286,6 +318,29 @@ void AsyncResponseStream::printf(const char *fmt, ...) {
   this->print(str);
 }
 
+void AsyncResponseStream::write_(const char *data, size_t len) {
+  if (this->content_.capacity() < CHUNK_SIZE)
+    this->content_.reserve(CHUNK_SIZE);
+  while (len != 0) {
+    size_t part = std::min(len, CHUNK_SIZE - this->content_.size());
+    this->content_.append(data, part);
+    data += part;
+    len -= part;
+    if (this->content_.size() == CHUNK_SIZE)
+      this->send_chunk_();
+  }
+}
+
+void AsyncResponseStream::send_chunk_() {
+  // once a chunk failed the client is gone, drop the rest of the content
+  if (!this->failed_ && httpd_resp_send_chunk(*this->req_, this->content_.data(), this->content_.size()) != ESP_OK) {
+    ESP_LOGW(TAG, "Sending response chunk failed");
+    this->failed_ = true;
+  }
+  this->chunked_ = true;
+  this->content_.clear();
+}
+
 AsyncEventSource::~AsyncEventSource() {
   for (auto *ses : this->sessions_) {
     delete ses;  // NOLINT(cppcoreguidelines-owning-memory)
@@ -306,6 +361,18 @@ void AsyncEventSource::send(const char *message, const char *event, uint32_t id,
   }
 }
 
+void AsyncEventSource::send_state(const char *message, const void *key, bool config) {
+  for (auto *ses : this->sessions_) {
+    ses->send_state(message, key, config);
+  }
+}
+
+void AsyncEventSource::loop() {
+  for (auto *ses : this->sessions_) {
+    ses->flush_();
+  }
+}
+
 AsyncEventSourceResponse::AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server)
     : server_(server) {
   httpd_req_t *req = *request;
@@ -335,6 +402,15 @@ void AsyncEventSourceResponse::destroy(void *ptr) {
 }
 
 void AsyncEventSourceResponse::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
+  this->send_(message, event, id, reconnect, nullptr, false);
+}
+
+void AsyncEventSourceResponse::send_state(const char *message, const void *key, bool config) {
+  this->send_(message, "state", 0, 0, key, config);
+}
+
+void AsyncEventSourceResponse::send_(const char *message, const char *event, uint32_t id, uint32_t reconnect,
+                                     const void *key, bool config) {
   if (this->fd_ == 0) {
     return;
   }
@@ -371,15 +447,69 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
 
   ev.append(CRLF_STR, CRLF_LEN);
 
-  // Sending chunked content prelude
-  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
+  // Queue the event as one chunk, so a slow client only delays itself
+  QueuedEvent queued;
+  queued.data = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
+  queued.data.append(ev);
+  queued.data.append(CRLF_STR, CRLF_LEN);
+  queued.droppable = event != nullptr && strcmp(event, "log") == 0;
+  queued.key = key;
+  queued.config = config;
+
+  // the first event can't be replaced or dropped once part of it was sent
+  auto begin = this->queue_.begin() + (this->sent_ > 0 ? 1 : 0);
+  if (queued.key != nullptr && !queued.config) {
+    // replace the last queued event of the entity, unless that one describes the entity and must be kept
+    auto it = std::find_if(this->queue_.rbegin(), std::make_reverse_iterator(begin),
+                           [&queued](const QueuedEvent &ev) { return ev.key == queued.key; });
+    if (it != std::make_reverse_iterator(begin) && !it->config) {
+      it->data = std::move(queued.data);
+      this->flush_();
+      return;
+    }
+  }
+
+  if (queued.droppable) {
+    size_t logs = std::count_if(begin, this->queue_.end(), [](const QueuedEvent &ev) { return ev.droppable; });
+    if (logs >= MAX_QUEUED_LOG_EVENTS)
+      this->queue_.erase(std::find_if(begin, this->queue_.end(), [](const QueuedEvent &ev) { return ev.droppable; }));
+  } else if (this->queue_.size() >= MAX_QUEUED_EVENTS) {
+    // dropping a state or config event would leave the client out of sync for good
+    ESP_LOGD(TAG, "Event source client is too slow, closing");
+    this->close_();
+    return;
+  }
+  this->queue_.push_back(std::move(queued));
+  this->flush_();
+}
 
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
+void AsyncEventSourceResponse::close_() {
+  httpd_sess_trigger_close(this->hd_, this->fd_);
+  this->fd_ = 0;
+  this->queue_.clear();
+  this->sent_ = 0;
+}
 
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+void AsyncEventSourceResponse::flush_() {
+  while (this->fd_ != 0 && !this->queue_.empty()) {
+    const std::string &data = this->queue_.front().data;
+    int ret = httpd_socket_send(this->hd_, this->fd_, data.data() + this->sent_, data.size() - this->sent_,
+                                MSG_DONTWAIT);
+    if (ret == HTTPD_SOCK_ERR_TIMEOUT) {
+      // socket buffer is full, try again later
+      return;
+    }
+    if (ret < 0) {
+      ESP_LOGD(TAG, "Event source client send failed, closing");
+      this->close_();
+      return;
+    }
+    this->sent_ += ret;
+    if (this->sent_ == data.size()) {
+      this->queue_.pop_front();
+      this->sent_ = 0;
+    }
+  }
 }
 
 }  // namespace web_server_idf
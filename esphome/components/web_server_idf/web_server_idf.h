@@ -3,6 +3,7 @@
 
 #include <esp_http_server.h>
 
+#include <deque>
 #include <string>
 #include <functional>
 #include <vector>
@@ -40,6 +41,9 @@ class AsyncWebServerResponse {
   virtual const char *get_content_data() const = 0;
   virtual size_t get_content_size() const = 0;
 
+  /// Send the content of the response, called once when the response is sent.
+  virtual esp_err_t send_content();
+
  protected:
   const AsyncWebServerRequest *req_;
 };
@@ -64,20 +68,36 @@ class AsyncWebServerResponseContent : public AsyncWebServerResponse {
   std::string content_;
 };
 
+/** Response that is written piece by piece.
+ *
+ * The content is buffered up to CHUNK_SIZE bytes. Longer responses are sent with chunked transfer encoding as they
+ * are written, so they never need more than one chunk of memory. Short responses are sent in one go when the response
+ * is sent.
+ */
 class AsyncResponseStream : public AsyncWebServerResponse {
  public:
+  static const size_t CHUNK_SIZE = 1024;
+
   AsyncResponseStream(const AsyncWebServerRequest *req) : AsyncWebServerResponse(req) {}
 
   const char *get_content_data() const override { return this->content_.c_str(); };
   size_t get_content_size() const override { return this->content_.size(); };
+  esp_err_t send_content() override;
 
-  void print(const char *str) { this->content_.append(str); }
-  void print(const std::string &str) { this->content_.append(str); }
+  void print(const char *str);
+  void print(const std::string &str) { this->write_(str.data(), str.size()); }
   void print(float value);
   void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
 
  protected:
+  void write_(const char *data, size_t len);
+  void send_chunk_();
+
+  /// content that hasn't been sent yet, at most one chunk
   std::string content_;
+  /// whether the content is being sent in chunks
+  bool chunked_{false};
+  bool failed_{false};
 };
 
 class AsyncWebServerResponseProgmem : public AsyncWebServerResponse {
@@ -218,13 +238,34 @@ class AsyncEventSourceResponse {
 
  public:
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  /// Send a state event of the entity identified by key, config tells whether it carries the full entity description.
+  void send_state(const char *message, const void *key, bool config);
 
  protected:
+  /// An event formatted as a complete HTTP chunk
+  struct QueuedEvent {
+    std::string data;
+    /// log events are dropped when too many of them are queued
+    bool droppable;
+    /// the entity of a state event, a newer state event of the same entity replaces it in the queue
+    const void *key;
+    /// the event describes the entity and is never replaced or dropped
+    bool config;
+  };
+
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  /// Send as much of the queue as the socket accepts without blocking.
+  void flush_();
+  /// Close the connection of a client that failed or fell too far behind.
+  void close_();
+  void send_(const char *message, const char *event, uint32_t id, uint32_t reconnect, const void *key, bool config);
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
+  std::deque<QueuedEvent> queue_;
+  /// bytes of the first queued event that were already sent
+  size_t sent_{0};
 };
 
 using AsyncEventSourceClient = AsyncEventSourceResponse;
@@ -247,6 +288,11 @@ class AsyncEventSource : public AsyncWebHandler {
   void onConnect(connect_handler_t cb) { this->on_connect_ = std::move(cb); }
 
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
+  /// Send a state event of an entity, see AsyncEventSourceResponse::send_state().
+  void send_state(const char *message, const void *key, bool config);
+  /// Send the queued events of clients that couldn't take them immediately, must be called regularly.
+  void loop();
+  size_t count() const { return this->sessions_.size(); }
 
  protected:
   std::string url_;
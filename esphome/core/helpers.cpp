@@ -173,11 +173,12 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc, uint16_t poly,
   return refout ? (crc ^ 0xffff) : crc;
 }
 
-uint32_t fnv1_hash(const std::string &str) {
+uint32_t fnv1_hash(const std::string &str) { return fnv1_hash(str.data(), str.size()); }
+uint32_t fnv1_hash(const char *str, size_t len) {
   uint32_t hash = 2166136261UL;
-  for (char c : str) {
+  for (size_t i = 0; i < len; i++) {
     hash *= 16777619UL;
-    hash ^= c;
+    hash ^= str[i];
   }
   return hash;
 }
@@ -0,0 +1,85 @@
+#include "ring_buffer.h"
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+
+std::unique_ptr<RingBuffer> RingBuffer::create(size_t len) {
+  size_t capacity = 1;
+  while (capacity < len)
+    capacity <<= 1;
+
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  uint8_t *storage = allocator.allocate(capacity);
+  if (storage == nullptr)
+    return nullptr;
+  return std::unique_ptr<RingBuffer>(new RingBuffer(storage, capacity));  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+RingBuffer::~RingBuffer() {
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  allocator.deallocate(this->storage_, this->capacity());
+}
+
+uint8_t *RingBuffer::write_span(size_t *len) {
+  const size_t head = this->head_.load(std::memory_order_relaxed);
+  const size_t tail = this->tail_.load(std::memory_order_acquire);
+  const size_t offset = head & this->mask_;
+  *len = std::min(this->capacity() - (head - tail), this->capacity() - offset);
+  return this->storage_ + offset;
+}
+
+void RingBuffer::commit_write(size_t len) {
+  this->head_.store(this->head_.load(std::memory_order_relaxed) + len, std::memory_order_release);
+}
+
+size_t RingBuffer::write(const void *data, size_t len) {
+  const auto *src = static_cast<const uint8_t *>(data);
+  size_t written = 0;
+  // at most two spans, before and after the wrap around
+  for (int i = 0; i < 2 && written < len; i++) {
+    size_t span;
+    uint8_t *dst = this->write_span(&span);
+    span = std::min(span, len - written);
+    if (span == 0)
+      break;
+    memcpy(dst, src + written, span);
+    this->commit_write(span);
+    written += span;
+  }
+  return written;
+}
+
+uint8_t *RingBuffer::read_span(size_t *len) {
+  const size_t tail = this->tail_.load(std::memory_order_relaxed);
+  const size_t head = this->head_.load(std::memory_order_acquire);
+  const size_t offset = tail & this->mask_;
+  *len = std::min(head - tail, this->capacity() - offset);
+  return this->storage_ + offset;
+}
+
+void RingBuffer::commit_read(size_t len) {
+  this->tail_.store(this->tail_.load(std::memory_order_relaxed) + len, std::memory_order_release);
+}
+
+size_t RingBuffer::read(void *data, size_t len) {
+  auto *dst = static_cast<uint8_t *>(data);
+  size_t read = 0;
+  for (int i = 0; i < 2 && read < len; i++) {
+    size_t span;
+    const uint8_t *src = this->read_span(&span);
+    span = std::min(span, len - read);
+    if (span == 0)
+      break;
+    memcpy(dst + read, src, span);
+    this->commit_read(span);
+    read += span;
+  }
+  return read;
+}
+
+void RingBuffer::reset() { this->tail_.store(this->head_.load(std::memory_order_acquire), std::memory_order_release); }
+
+}  // namespace esphome
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+
+/** Lock-free ring buffer of bytes for exactly one producer and one consumer.
+ *
+ * The producer and the consumer may run on different tasks without any further locking. Both sides can work on the
+ * buffer memory in place: the producer fills the span returned by write_span() and publishes it with commit_write(),
+ * the consumer processes the span returned by read_span() and releases it with commit_read(). A span never wraps
+ * around the end of the buffer, so the rest of the data is returned by the next call after committing.
+ *
+ * The buffer memory is allocated in external RAM when it's available.
+ */
+class RingBuffer {
+ public:
+  /// Create a ring buffer holding at least len bytes, or nullptr if the memory couldn't be allocated.
+  static std::unique_ptr<RingBuffer> create(size_t len);
+  ~RingBuffer();
+
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+
+  // ========== PRODUCER ==========
+  /// Return the contiguous free space for writing, its size is stored in len.
+  uint8_t *write_span(size_t *len);
+  /// Publish len bytes written to the span returned by write_span().
+  void commit_write(size_t len);
+  /// Copy up to len bytes into the buffer, returns the number of bytes written.
+  size_t write(const void *data, size_t len);
+
+  // ========== CONSUMER ==========
+  /// Return the contiguous data available for reading, its size is stored in len. The data may be modified in place.
+  uint8_t *read_span(size_t *len);
+  /// Release len bytes of the span returned by read_span().
+  void commit_read(size_t len);
+  /// Copy up to len bytes out of the buffer, returns the number of bytes read.
+  size_t read(void *data, size_t len);
+  /// Discard all data that is currently in the buffer.
+  void reset();
+
+  /// Number of bytes available for reading.
+  size_t available() const {
+    return this->head_.load(std::memory_order_acquire) - this->tail_.load(std::memory_order_acquire);
+  }
+  /// Number of bytes that can be written.
+  size_t free() const { return this->capacity() - this->available(); }
+  size_t capacity() const { return this->mask_ + 1; }
+
+ protected:
+  RingBuffer(uint8_t *storage, size_t capacity) : storage_(storage), mask_(capacity - 1) {}
+
+  uint8_t *storage_;
+  /// capacity - 1, the capacity is a power of two
+  size_t mask_;
+  /// Total number of bytes written and read, wrapping around. Only the producer writes head_, only the consumer tail_.
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+};
+
+}  // namespace esphome